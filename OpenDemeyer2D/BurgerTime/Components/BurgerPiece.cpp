@@ -87,7 +87,7 @@ void BurgerPiece::FallDown(const glm::vec2& location)
 	{
 		GetGameObject()->GetTransform()->Move({ 0,-2.f });
 
-		std::vector<Enemy*> OverlappingEnemies{};
+		FrameVector<Enemy*> OverlappingEnemies{};
 
 		for (int i{}; i < 4; ++i)
 		{
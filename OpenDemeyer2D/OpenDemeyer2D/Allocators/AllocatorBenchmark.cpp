@@ -0,0 +1,204 @@
+﻿#include "pch.h"
+#include "AllocatorBenchmark.h"
+
+#include <chrono>
+#include <vector>
+
+#include "ObjectPoolAllocator.h"
+#include "SmallObjectAllocator.h"
+#include "NewDeleteOverride.h"
+
+/** Slots of a single size, the next free slot is searched for in a vector<bool> after every allocation.*/
+class ScanningPool final
+{
+public:
+
+	ScanningPool(size_t elementSize, size_t elementAmount)
+		: m_Data{ static_cast<uint8_t*>(malloc(elementSize * elementAmount)) }
+		, m_ElementSize{ elementSize }
+		, m_pNextFreeSpace{ m_Data }
+		, m_FreeSpaces{ elementAmount }
+		, m_OccupiedPlaces(elementAmount, false)
+	{
+	}
+	~ScanningPool()
+	{
+		free(m_Data);
+	}
+
+	ScanningPool(const ScanningPool&) = delete;
+	ScanningPool& operator=(const ScanningPool&) = delete;
+
+	size_t GetMaxElementAmount() const { return m_OccupiedPlaces.size(); }
+	size_t GetFreeSpaces() const { return m_FreeSpaces; }
+	bool contains(const void* address) const { return address >= m_Data && address < m_Data + m_ElementSize * GetMaxElementAmount(); }
+
+	void* allocate()
+	{
+		void* returnValue{ m_pNextFreeSpace };
+
+		size_t pos{ size_t(m_pNextFreeSpace - m_Data) / m_ElementSize };
+		m_OccupiedPlaces[pos] = true;
+
+		if (--m_FreeSpaces == 0)
+			return returnValue;
+
+		while (m_OccupiedPlaces[pos])
+			++pos %= GetMaxElementAmount();
+
+		m_pNextFreeSpace = m_Data + pos * m_ElementSize;
+		return returnValue;
+	}
+
+	void deallocate(void* ptr)
+	{
+		m_OccupiedPlaces[size_t(static_cast<uint8_t*>(ptr) - m_Data) / m_ElementSize] = false;
+		++m_FreeSpaces;
+		m_pNextFreeSpace = static_cast<uint8_t*>(ptr);
+	}
+
+private:
+
+	uint8_t* m_Data{};
+	size_t m_ElementSize{};
+	uint8_t* m_pNextFreeSpace{};
+	size_t m_FreeSpaces{};
+	std::vector<bool> m_OccupiedPlaces;
+
+};
+
+/**
+ * Pools of a single size that are searched one by one, for free space when allocating and for the owner when deallocating.
+ * New pools either have a fixed size, like the chunks of the ObjectPoolAllocator, or double in size like the SmallObjectPools.
+ */
+class ScanningPools final
+{
+public:
+
+	ScanningPools(size_t elementSize, size_t firstPoolSize, bool doublePoolSize)
+		: m_ElementSize{ elementSize }
+		, m_NextPoolSize{ firstPoolSize }
+		, m_DoublePoolSize{ doublePoolSize }
+	{
+	}
+
+	void* allocate()
+	{
+		for (auto rIt{ m_Pools.rbegin() }; rIt != m_Pools.rend(); ++rIt)
+		{
+			if ((*rIt)->GetFreeSpaces())
+				return (*rIt)->allocate();
+		}
+
+		m_Pools.emplace_back(std::make_unique<ScanningPool>(m_ElementSize, m_NextPoolSize));
+		if (m_DoublePoolSize)
+			m_NextPoolSize *= 2;
+
+		return m_Pools.back()->allocate();
+	}
+
+	void deallocate(void* ptr)
+	{
+		for (auto& pPool : m_Pools)
+		{
+			if (pPool->contains(ptr))
+			{
+				pPool->deallocate(ptr);
+				return;
+			}
+		}
+	}
+
+private:
+
+	size_t m_ElementSize{};
+	size_t m_NextPoolSize{};
+	bool m_DoublePoolSize{};
+	std::vector<std::unique_ptr<ScanningPool>> m_Pools;
+
+};
+
+/** Fills the allocator, frees one out of every hundred objects and then keeps it full by freeing and allocating again. Returns the duration in milliseconds*/
+template <typename Allocate, typename Deallocate>
+static float RunChurn(int objectAmount, int churnAmount, Allocate&& allocate, Deallocate&& deallocate)
+{
+	std::vector<void*> objects(size_t(objectAmount), nullptr);
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (void*& pObject : objects)
+		pObject = allocate();
+
+	for (size_t i{}; i < objects.size(); i += 100)
+	{
+		deallocate(objects[i]);
+		objects[i] = nullptr;
+	}
+
+	// Spread over the whole allocator instead of reusing the same few slots
+	for (int i{}; i < churnAmount; ++i)
+	{
+		void*& pObject = objects[(size_t(i) * 7919) % objects.size()];
+		if (!pObject)
+			continue;
+
+		deallocate(pObject);
+		pObject = allocate();
+	}
+
+	for (void* pObject : objects)
+	{
+		if (pObject)
+			deallocate(pObject);
+	}
+
+	return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+std::pair<float, float> BenchmarkObjectPoolAllocator(int objectAmount, int churnAmount)
+{
+	struct Object { float data[12]; };
+	constexpr size_t chunkSize{ 256 };
+
+	float currentDuration{};
+	{
+		ObjectPoolAllocator<Object> allocator{ chunkSize };
+		currentDuration = RunChurn(objectAmount, churnAmount,
+			[&allocator]() -> void* { return allocator.allocate(); },
+			[&allocator](void* ptr) { allocator.deallocate(static_cast<Object*>(ptr)); });
+	}
+
+	float scanningDuration{};
+	{
+		ScanningPools allocator{ sizeof(Object), chunkSize, false };
+		scanningDuration = RunChurn(objectAmount, churnAmount,
+			[&allocator]() { return allocator.allocate(); },
+			[&allocator](void* ptr) { allocator.deallocate(ptr); });
+	}
+
+	return { currentDuration, scanningDuration };
+}
+
+std::pair<float, float> BenchmarkSmallObjectAllocator(int objectAmount, int churnAmount)
+{
+	constexpr size_t elementSize{ 32 };
+
+	float currentDuration{};
+	{
+		auto& allocator = GetSmallObjectAllocator();
+		currentDuration = RunChurn(objectAmount, churnAmount,
+			[&allocator]() { return allocator.allocate(elementSize); },
+			[&allocator](void* ptr) { allocator.deallocate(ptr, elementSize); });
+	}
+
+	// The first pool of the old allocator in this size class held 128 elements
+	float scanningDuration{};
+	{
+		ScanningPools allocator{ elementSize, 128, true };
+		scanningDuration = RunChurn(objectAmount, churnAmount,
+			[&allocator]() { return allocator.allocate(); },
+			[&allocator](void* ptr) { allocator.deallocate(ptr); });
+	}
+
+	return { currentDuration, scanningDuration };
+}
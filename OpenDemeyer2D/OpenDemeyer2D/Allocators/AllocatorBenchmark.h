@@ -0,0 +1,18 @@
+﻿#pragma once
+
+#include <utility>
+
+/**
+ * Microbenchmarks of the pool allocators against the scanning pools they replaced.
+ * The old pools marked their occupied slots in a vector<bool> and searched it for the next free slot after every allocation,
+ * the allocators searched their pools or chunks one by one for free space and for the owner of a freed pointer.
+ *
+ * Every benchmark fills the pool with objectAmount objects, frees one out of every hundred and then frees and allocates churnAmount times,
+ * keeping the pool 99% full. The first duration is of the current allocator and the second of the scanning one, both in milliseconds.
+ */
+
+/** ObjectPoolAllocator with chunks of 256, like the component pools, against the scanning ObjectPoolAllocator.*/
+std::pair<float, float> BenchmarkObjectPoolAllocator(int objectAmount, int churnAmount);
+
+/** The 32 byte size class of the SmallObjectAllocator against scanning SmallObjectPools that double in size.*/
+std::pair<float, float> BenchmarkSmallObjectAllocator(int objectAmount, int churnAmount);
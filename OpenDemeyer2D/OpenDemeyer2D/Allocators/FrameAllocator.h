@@ -0,0 +1,40 @@
+﻿#pragma once
+
+#include <vector>
+#include "NewDeleteOverride.h"
+#include "StackAllocator.h"
+
+/**
+ * STL allocator that takes its memory from the frame stack allocator (GetStackAllocator()).
+ * The stack is reset at the start of every frame, so containers using it may not outlive the frame.
+ * Deallocating does nothing and the frame stack is not thread safe, only use it on the main thread.
+ *
+ * How to use:
+ * FrameVector<GameObject*> hits{};
+ * hits.reserve(16);
+ */
+template <class T>
+struct FrameAllocator
+{
+	typedef T value_type;
+	FrameAllocator() noexcept {}
+
+	template<class U> FrameAllocator(const FrameAllocator<U>&) noexcept {}
+	template<class U> bool operator==(const FrameAllocator<U>&) const noexcept
+	{
+		return true;
+	}
+	template<class U> bool operator!=(const FrameAllocator<U>&) const noexcept
+	{
+		return false;
+	}
+
+	T* allocate(const size_t n) const
+	{
+		return GetStackAllocator().allocate<T>(n);
+	}
+	void deallocate(T* const, size_t) const noexcept {}
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
@@ -1,20 +1,36 @@
 ﻿#pragma once
 
 #include <cassert>
+#include <cstddef>
 #include <new>
 #include <memory>
 #include <vector>
 
+/**
+ * Fixed amount of slots for objects of type T.
+ * Freed slots form an intrusive linked list, slots that have never been handed out are taken from the back of the chunk.
+ * Every slot starts with the index of its chunk so the owning chunk of an object is found without searching.
+ */
 template <typename T>
 class ObjectPoolChunk final
 {
+	struct Slot
+	{
+		size_t chunkIndex;
+		union
+		{
+			Slot* pNext;
+			alignas(T) unsigned char data[sizeof(T)];
+		};
+	};
+
 public:
-	ObjectPoolChunk(size_t size)
-		: m_Data{ static_cast<T*>(malloc(size * sizeof(T))) }
+	ObjectPoolChunk(size_t size, size_t index)
+		: m_Data{ static_cast<Slot*>(malloc(size * sizeof(Slot))) }
 		, m_Size{ size }
-		, m_NextFreeSpace{ m_Data }
+		, m_Index{ index }
+		, m_pUntouched{ m_Data }
 		, m_FreeSpaces{ size }
-		, m_OccupiedPlaces(size, false)
 	{
 	}
 	~ObjectPoolChunk()
@@ -25,25 +41,25 @@ public:
 	ObjectPoolChunk(ObjectPoolChunk<T>&& other) noexcept
 		: m_Data{ other.m_Data }
 		, m_Size{ other.m_Size }
-		, m_NextFreeSpace{ other.m_NextFreeSpace }
+		, m_Index{ other.m_Index }
+		, m_pFreeList{ other.m_pFreeList }
+		, m_pUntouched{ other.m_pUntouched }
 		, m_FreeSpaces{ other.m_FreeSpaces }
-		, m_OccupiedPlaces(std::move(other.m_OccupiedPlaces))
 	{
 		other.m_FreeSpaces = 0;
 		other.m_Data = nullptr;
 		other.m_Size = 0;
+		other.m_pFreeList = nullptr;
+		other.m_pUntouched = nullptr;
 	}
 	ObjectPoolChunk& operator=(ObjectPoolChunk<T>&& other) noexcept
 	{
-		m_Data = other.m_Data;
-		m_Size = other.m_Size;
-		m_NextFreeSpace = other.m_NextFreeSpace;
-		m_FreeSpaces = other.m_FreeSpaces;
-		m_OccupiedPlaces = std::move(other.m_OccupiedPlaces);
-
-		other.m_FreeSpaces = 0;
-		other.m_Data = nullptr;
-		other.m_Size = 0;
+		std::swap(m_Data, other.m_Data);
+		std::swap(m_Size, other.m_Size);
+		std::swap(m_Index, other.m_Index);
+		std::swap(m_pFreeList, other.m_pFreeList);
+		std::swap(m_pUntouched, other.m_pUntouched);
+		std::swap(m_FreeSpaces, other.m_FreeSpaces);
 		return *this;
 	}
 
@@ -53,57 +69,60 @@ public:
 	size_t GetMaxElementAmount() const { return m_Size; }
 	size_t GetElementAmount() const { return GetMaxElementAmount() - m_FreeSpaces; }
 	size_t GetFreeSpaces() const { return m_FreeSpaces; }
-	bool contains(const T* address) const { return (address < m_Data + m_Size) && (address >= m_Data); }
+	bool contains(const T* address) const
+	{
+		auto pSlot = ToSlot(address);
+		return (pSlot < m_Data + m_Size) && (pSlot >= m_Data);
+	}
+
+	/** Returns the index of the chunk that handed out the object, read from the header of its slot.*/
+	static size_t GetChunkIndex(const T* address) { return ToSlot(address)->chunkIndex; }
 
 	T* allocate()
 	{
 		if (!m_FreeSpaces) throw std::bad_alloc();
 
-		assert(m_NextFreeSpace);
-
-		T* returnValue = m_NextFreeSpace;
-
-		size_t pos = m_NextFreeSpace - m_Data;
-		m_OccupiedPlaces[pos] = true;
-
 		--m_FreeSpaces;
 
-		if (!m_FreeSpaces)
-			return returnValue;
-
-		while (true)
+		Slot* pSlot{ m_pFreeList };
+		if (pSlot)
 		{
-			assert(pos < m_Size);
-
-			if (m_OccupiedPlaces[pos] == false)
-			{
-				m_NextFreeSpace = m_Data + pos;
-				return returnValue;
-			}
-			else
-			{
-				++pos %= GetMaxElementAmount();
-			}
+			m_pFreeList = pSlot->pNext;
 		}
+		else
+		{
+			assert(m_pUntouched < m_Data + m_Size);
+			pSlot = m_pUntouched++;
+			pSlot->chunkIndex = m_Index;
+		}
+
+		return reinterpret_cast<T*>(pSlot->data);
 	}
 	void deallocate(T* ptr)
 	{
-		size_t pos = ptr - m_Data;
-		assert(pos < m_Size);
-		m_OccupiedPlaces[pos] = false;
+		assert(contains(ptr));
+
+		auto pSlot = const_cast<Slot*>(ToSlot(ptr));
+		pSlot->pNext = m_pFreeList;
+		m_pFreeList = pSlot;
 
 		++m_FreeSpaces;
-		m_NextFreeSpace = ptr;
 	}
 
 private:
 
-	T* m_Data{};
+	static const Slot* ToSlot(const T* address)
+	{
+		return reinterpret_cast<const Slot*>(reinterpret_cast<const unsigned char*>(address) - offsetof(Slot, data));
+	}
+
+	Slot* m_Data{};
 	size_t m_Size{};
-	T* m_NextFreeSpace{};
+	size_t m_Index{};
+	Slot* m_pFreeList{};
+	Slot* m_pUntouched{};
 
 	size_t m_FreeSpaces{};
-	std::vector<bool> m_OccupiedPlaces;
 
 };
 
@@ -120,28 +139,33 @@ public:
 
 	T* allocate()
 	{
-		for (auto rIt{ m_Chunks.rbegin() }; rIt != m_Chunks.rend(); ++rIt)
+		if (m_AvailableChunks.empty())
 		{
-			if (rIt->GetFreeSpaces() != 0)
-			{
-				return rIt->allocate();
-			}
+			m_Chunks.emplace_back(ChunkSize, m_Chunks.size());
+			m_AvailableChunks.emplace_back(m_Chunks.size() - 1);
 		}
 
-		m_Chunks.emplace_back(ChunkSize);
-		return m_Chunks.back().allocate();
+		auto& chunk = m_Chunks[m_AvailableChunks.back()];
+		T* ptr = chunk.allocate();
+
+		if (!chunk.GetFreeSpaces())
+			m_AvailableChunks.pop_back();
+
+		return ptr;
 	}
 
 	void deallocate(T* ptr)
 	{
-		for (auto& chunk : m_Chunks)
-		{
-			if (chunk.contains(ptr))
-			{
-				chunk.deallocate(ptr);
-				return;
-			}
-		}
+		const size_t index{ ObjectPoolChunk<T>::GetChunkIndex(ptr) };
+		assert(index < m_Chunks.size());
+
+		auto& chunk = m_Chunks[index];
+
+		// The chunk was full so it is not in the available list yet
+		if (!chunk.GetFreeSpaces())
+			m_AvailableChunks.emplace_back(index);
+
+		chunk.deallocate(ptr);
 	}
 
 private:
@@ -149,5 +173,7 @@ private:
 	size_t ChunkSize{};
 	std::vector<ObjectPoolChunk<T>> m_Chunks;
 
+	// Indices of the chunks that still have free space, the last one is used first
+	std::vector<size_t> m_AvailableChunks;
 
 };
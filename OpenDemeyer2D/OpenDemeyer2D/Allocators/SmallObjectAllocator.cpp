@@ -2,122 +2,93 @@
 #include "SmallObjectAllocator.h"
 
 #include <numeric>
+#include <cstring>
 
 // SmallObjectPool
 // SmallObjectPool
 // SmallObjectPool
 
-SmallObjectPool::SmallObjectPool(size_t dataSize, size_t elementAmount)
-	: m_Data{ malloc(dataSize * elementAmount) }
-	, m_Size{ dataSize * elementAmount }
-	, m_NextFreeSpace{ m_Data }
-	, m_FreeSpaces{ elementAmount }
-	, m_OccupiedPlaces(elementAmount, false)
+constexpr size_t SmallObjectPool::HeaderSize()
 {
-	assert(m_Data);
+	return (sizeof(SmallObjectPool) + 15) & ~size_t(15);
 }
 
-SmallObjectPool::SmallObjectPool(size_t dataSize, size_t elementAmount, StackAllocator& allocator)
-	: m_Data{ allocator.allocate(dataSize * elementAmount) }
-	, m_Size{ dataSize * elementAmount }
-	, m_NextFreeSpace{ m_Data }
-	, m_FreeSpaces{ elementAmount }
-	, m_OccupiedPlaces(elementAmount, false)
+SmallObjectPool::SmallObjectPool(size_t dataSize)
+	: m_Data{ reinterpret_cast<uint8_t*>(this) + HeaderSize() }
+	, m_ElementSize{ dataSize }
+	, m_ElementAmount{ (SlabSize - HeaderSize()) / GetStride(dataSize) }
+	, m_FreeSpaces{ m_ElementAmount }
+	, m_pUntouched{ m_Data }
 {
-	assert(m_Data);
-}
-
-SmallObjectPool::~SmallObjectPool()
-{
-	free(m_Data);
-}
-
-SmallObjectPool::SmallObjectPool(SmallObjectPool&& other) noexcept
-	: m_Data{ other.m_Data }
-	, m_Size{ other.m_Size }
-	, m_NextFreeSpace{ other.m_NextFreeSpace }
-	, m_FreeSpaces{ other.m_FreeSpaces }
-	, m_OccupiedPlaces(std::move(other.m_OccupiedPlaces))
-{
-	other.m_Size = 0;
-	other.m_Data = nullptr;
-	other.m_NextFreeSpace = nullptr;
-	other.m_FreeSpaces = 0;
-}
-
-SmallObjectPool& SmallObjectPool::operator=(SmallObjectPool&& other) noexcept
-{
-	m_Data = other.m_Data;
-	m_Size = other.m_Size;
-	m_NextFreeSpace = other.m_NextFreeSpace;
-	m_FreeSpaces = other.m_FreeSpaces;
-	m_OccupiedPlaces = std::move(other.m_OccupiedPlaces);
-
-	other.m_Size = 0;
-	other.m_Data = nullptr;
-	other.m_NextFreeSpace = nullptr;
-	other.m_FreeSpaces = 0;
-	return *this;
+	assert(FromAddress(this) == this);
 }
 
 bool SmallObjectPool::contains(void* address) const
 {
-	return (address < static_cast<uint8_t*>(m_Data) + m_Size) && address >= m_Data;
+	return (address < end()) && address >= m_Data;
 }
 
 void* SmallObjectPool::allocate()
 {
 	if (!m_FreeSpaces) throw std::bad_alloc();
 
-	void* returnValue = m_NextFreeSpace;
-
-	size_t pos = (static_cast<uint8_t*>(m_NextFreeSpace) - static_cast<uint8_t*>(m_Data)) / GetElementSize();
-	m_OccupiedPlaces[pos] = true;
-
 	--m_FreeSpaces;
 
-	size_t elementSize{ GetElementSize() };
-
-	if (m_FreeSpaces == 0)
-		return returnValue;
-
-	++pos %= GetMaxElementAmount();
-	while (true)
+	if (m_pFreeList)
 	{
-		if (m_OccupiedPlaces[pos] == false)
-		{
-			m_NextFreeSpace = (static_cast<uint8_t*>(m_Data) + elementSize * pos);
-			return returnValue;
-		}
-		else
-		{
-			++pos %= GetMaxElementAmount();
-		}
+		void* returnValue = m_pFreeList;
+		std::memcpy(&m_pFreeList, returnValue, sizeof(void*));
+		return returnValue;
 	}
+
+	void* returnValue = m_pUntouched;
+	m_pUntouched += GetStride(m_ElementSize);
+	assert(m_pUntouched <= end());
+	return returnValue;
 }
 
 void SmallObjectPool::deallocate(void* ptr)
 {
-	size_t pos = (static_cast<uint8_t*>(ptr) - static_cast<uint8_t*>(m_Data)) / GetElementSize();
-	assert(pos < GetMaxElementAmount());
-	m_OccupiedPlaces[pos] = false;
+	assert(contains(ptr));
+	assert((static_cast<uint8_t*>(ptr) - m_Data) % GetStride(m_ElementSize) == 0);
+
+	// The block is free so its memory can hold the link to the next free block
+	std::memcpy(ptr, &m_pFreeList, sizeof(void*));
+	m_pFreeList = ptr;
 
 	++m_FreeSpaces;
-	m_NextFreeSpace = ptr;
 }
 
 void* SmallObjectPool::end() const
 {
-	return static_cast<uint8_t*>(m_Data) + m_Size;
+	return m_Data + m_ElementAmount * GetStride(m_ElementSize);
 }
 
 // SmallObjectAllocator
 // SmallObjectAllocator
 // SmallObjectAllocator
 
-SmallObjectAllocator::SmallObjectAllocator()
+namespace
 {
-	initialize();
+	// Trivially destructible so they stay usable while the other thread local and static objects get destroyed
+	thread_local SmallObjectAllocator::ThreadCache* t_pThreadCache{};
+	thread_local bool t_ThreadCacheDestroyed{};
+
+	struct ThreadCacheOwner final
+	{
+		~ThreadCacheOwner()
+		{
+			t_ThreadCacheDestroyed = true;
+			if (t_pThreadCache)
+			{
+				t_pThreadCache->pOwner->FlushThreadCache();
+				free(t_pThreadCache);
+				t_pThreadCache = nullptr;
+			}
+		}
+	};
+
+	thread_local ThreadCacheOwner t_ThreadCacheOwner;
 }
 
 void* SmallObjectAllocator::allocate(size_t count)
@@ -131,24 +102,23 @@ void* SmallObjectAllocator::allocate(size_t count)
 		return ptr;
 	}
 
-	auto& pools{ m_Pools[count - 1] };
-	for (SmallObjectPool& pool : pools)
+	void* ptr{};
+	if (auto pCache = GetThreadCache())
 	{
-		if (pool.GetFreeSpaces())
-		{
-			auto ptr = pool.allocate();
-			assert(ptr);
-#ifdef _DEBUG
-			m_MemoryAsserter.emplace(size_t(ptr), count);
-#endif
-			return ptr;
-		}
+		auto& bin = pCache->bins[count - 1];
+		if (!bin.count)
+			RefillBin(bin, count);
+		ptr = bin.blocks[--bin.count];
+	}
+	else
+	{
+		std::lock_guard lock{ m_PoolMutex };
+		ptr = AllocateFromPools(count);
 	}
-	auto& pool = pools.emplace_back(count, pools.back().GetMaxElementAmount() * 2);
-	m_AddressLookUpSet.insert(AddressLookUp(pool.data(), count, pool.end()));
-	auto ptr = pool.allocate();
 	assert(ptr);
+
 #ifdef _DEBUG
+	std::lock_guard debugLock{ m_MemoryAsserterMutex };
 	m_MemoryAsserter.emplace(size_t(ptr), count);
 #endif
 	return ptr;
@@ -159,28 +129,14 @@ void SmallObjectAllocator::deallocate(void* ptr)
 	if (!ptr)
 		return;
 
-	auto lower_bound = --m_AddressLookUpSet.end();
-	if (ptr < m_AddressLookUpSet.rbegin()->address)
+	if (auto pPool = FindPool(ptr))
 	{
-		lower_bound = m_AddressLookUpSet.lower_bound(AddressLookUp(ptr, 0));
-		if (!(lower_bound != m_AddressLookUpSet.end() && lower_bound->address == ptr) && --lower_bound == m_AddressLookUpSet.end())
-		{
-#ifdef _DEBUG
-			assert(!m_MemoryAsserter.contains(size_t(ptr)));
-#endif
-			free(ptr);
-			return;
-		}
-	}
-	
-	assert(ptr >= lower_bound->address);
-	if (ptr < lower_bound->poolEnd)
-	{
-		deallocate(ptr, lower_bound->elementSize);
+		deallocate(ptr, pPool->GetElementSize());
 	}
 	else
 	{
 #ifdef _DEBUG
+		std::lock_guard debugLock{ m_MemoryAsserterMutex };
 		assert(!m_MemoryAsserter.contains(size_t(ptr)));
 #endif
 		free(ptr);
@@ -189,43 +145,162 @@ void SmallObjectAllocator::deallocate(void* ptr)
 
 void SmallObjectAllocator::deallocate(void* ptr, size_t count)
 {
-	if (count <= MaxElementSize)
+	if (count > MaxElementSize)
 	{
-		auto& pools{ m_Pools[count - 1] };
-		for (SmallObjectPool& pool : pools)
-		{
-			assert(pool.GetElementSize() == count);
-			if (pool.contains(ptr))
-			{
 #ifdef _DEBUG
-				auto it = m_MemoryAsserter.find(size_t(ptr));
-				assert(it != m_MemoryAsserter.end());
-				assert(it->second == count);
-				m_MemoryAsserter.erase(it);
+		std::lock_guard debugLock{ m_MemoryAsserterMutex };
+		assert(!m_MemoryAsserter.contains(size_t(ptr)));
 #endif
-				pool.deallocate(ptr);
-				return;
-			}
-		}
+		free(ptr);
+		return;
 	}
-	else
-	{
+
 #ifdef _DEBUG
-		assert(!m_MemoryAsserter.contains(size_t(ptr)));
+	{
+		std::lock_guard debugLock{ m_MemoryAsserterMutex };
+		auto it = m_MemoryAsserter.find(size_t(ptr));
+		assert(it != m_MemoryAsserter.end());
+		assert(it->second == count);
+		m_MemoryAsserter.erase(it);
+	}
 #endif
-		free(ptr);
+
+	if (auto pCache = GetThreadCache())
+	{
+		auto& bin = pCache->bins[count - 1];
+		if (bin.count == ThreadCacheSize)
+			DrainBin(bin, count, ThreadCacheBatchSize);
+		bin.blocks[bin.count++] = ptr;
+	}
+	else
+	{
+		std::lock_guard lock{ m_PoolMutex };
+		DeallocateToPools(ptr, count);
 	}
 }
 
-void SmallObjectAllocator::initialize()
+void SmallObjectAllocator::FlushThreadCache()
 {
-	for (size_t i{ 1 }; i <= MaxElementSize; ++i)
+	if (!t_pThreadCache || t_pThreadCache->pOwner != this)
+		return;
+
+	for (size_t i{}; i < MaxElementSize; ++i)
 	{
-		size_t size = InitialMaxSize;
-		size *= i & 0b11 ? 1 : Multiple4Multiplier;
-		size *= i & 0b111 ? 1 : Multiple8Multiplier;
-		size /= i;
-		auto& pool = m_Pools[i - 1].emplace_back(i, size);
-		m_AddressLookUpSet.insert(AddressLookUp{ pool.data(), i, pool.end() });
+		auto& bin = t_pThreadCache->bins[i];
+		if (bin.count)
+			DrainBin(bin, i + 1, bin.count);
 	}
 }
+
+void* SmallObjectAllocator::AllocateFromPools(size_t count)
+{
+	auto& availablePools{ m_AvailablePools[count - 1] };
+
+	if (availablePools.empty())
+		availablePools.emplace_back(CreatePool(count));
+
+	auto pPool = availablePools.back();
+	void* ptr = pPool->allocate();
+
+	if (!pPool->GetFreeSpaces())
+		availablePools.pop_back();
+
+	return ptr;
+}
+
+void SmallObjectAllocator::DeallocateToPools(void* ptr, size_t count)
+{
+	auto pPool = SmallObjectPool::FromAddress(ptr);
+	assert(FindPool(ptr) == pPool);
+	assert(pPool->GetElementSize() == count);
+
+	// The pool was full so it is not in the available list yet
+	if (!pPool->GetFreeSpaces())
+		m_AvailablePools[count - 1].emplace_back(pPool);
+
+	pPool->deallocate(ptr);
+}
+
+SmallObjectPool* SmallObjectAllocator::CreatePool(size_t count)
+{
+	// VirtualAlloc hands out memory aligned to 64KB, the same as the slab size
+	void* pSlab = VirtualAlloc(nullptr, SmallObjectPool::SlabSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	if (!pSlab) throw std::bad_alloc();
+	assert((uintptr_t(pSlab) & (SmallObjectPool::SlabSize - 1)) == 0);
+
+	const uintptr_t slabIndex{ uintptr_t(pSlab) >> SlabBits };
+	const uintptr_t rootIndex{ slabIndex >> LeafBits };
+	assert(rootIndex < m_SlabMap.size());
+
+	uint8_t* pLeaf = m_SlabMap[rootIndex].load(std::memory_order_acquire);
+	if (!pLeaf)
+	{
+		pLeaf = static_cast<uint8_t*>(calloc(size_t(1) << LeafBits, 1));
+		if (!pLeaf) throw std::bad_alloc();
+		m_SlabMap[rootIndex].store(pLeaf, std::memory_order_release);
+	}
+
+	auto pPool = new (pSlab) SmallObjectPool(count);
+	pLeaf[slabIndex & ((uintptr_t(1) << LeafBits) - 1)] = 1;
+
+	m_Pools[count - 1].emplace_back(pPool);
+	return pPool;
+}
+
+SmallObjectPool* SmallObjectAllocator::FindPool(void* ptr) const
+{
+	const uintptr_t slabIndex{ uintptr_t(ptr) >> SlabBits };
+	const uintptr_t rootIndex{ slabIndex >> LeafBits };
+	if (rootIndex >= m_SlabMap.size())
+		return nullptr;
+
+	const uint8_t* pLeaf = m_SlabMap[rootIndex].load(std::memory_order_acquire);
+	if (!pLeaf || !pLeaf[slabIndex & ((uintptr_t(1) << LeafBits) - 1)])
+		return nullptr;
+
+	return SmallObjectPool::FromAddress(ptr);
+}
+
+SmallObjectAllocator::ThreadCache* SmallObjectAllocator::GetThreadCache()
+{
+	if (t_pThreadCache)
+		return t_pThreadCache->pOwner == this ? t_pThreadCache : nullptr;
+
+	// The thread is shutting down, from here on every request goes straight to the pools
+	if (t_ThreadCacheDestroyed)
+		return nullptr;
+
+	auto pMemory = malloc(sizeof(ThreadCache));
+	if (!pMemory)
+		return nullptr;
+
+	t_pThreadCache = new (pMemory) ThreadCache{};
+	t_pThreadCache->pOwner = this;
+
+	// Touch the owner so it gets constructed and returns the cache when the thread exits
+	static_cast<void>(&t_ThreadCacheOwner);
+
+	return t_pThreadCache;
+}
+
+void SmallObjectAllocator::RefillBin(ThreadCache::Bin& bin, size_t count)
+{
+	std::lock_guard lock{ m_PoolMutex };
+	while (bin.count < ThreadCacheBatchSize)
+		bin.blocks[bin.count++] = AllocateFromPools(count);
+}
+
+void SmallObjectAllocator::DrainBin(ThreadCache::Bin& bin, size_t count, size_t amount)
+{
+	assert(amount <= bin.count);
+
+	// Return the oldest blocks and keep the most recently freed (and likely cached) ones
+	{
+		std::lock_guard lock{ m_PoolMutex };
+		for (size_t i{}; i < amount; ++i)
+			DeallocateToPools(bin.blocks[i], count);
+	}
+
+	std::move(bin.blocks + amount, bin.blocks + bin.count, bin.blocks);
+	bin.count -= amount;
+}
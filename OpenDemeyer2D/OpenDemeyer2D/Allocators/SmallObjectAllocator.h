@@ -2,31 +2,39 @@
 
 #include <vector>
 #include <array>
-#include <set>
+#include <atomic>
 #include <unordered_map>
-#include "StackAllocator.h"
+#include <mutex>
 
 #include "Mallocator.h"
 
+/**
+ * Fixed size block pool that lives at the start of its own aligned slab.
+ * Freed blocks form an intrusive linked list, the blocks that have never been handed out are taken from the back of the slab.
+ * Both allocate and deallocate are O(1).
+ */
 class SmallObjectPool final
 {
 public:
 
-	SmallObjectPool(size_t dataSize, size_t elementAmount);
-	SmallObjectPool(size_t dataSize, size_t elementAmount, StackAllocator& allocator);
-	~SmallObjectPool();
+	// Slabs are aligned to their size so the pool of any block is found by masking the address
+	static constexpr size_t SlabSize{ 1 << 16 };
 
-	SmallObjectPool(SmallObjectPool&& other) noexcept;
-	SmallObjectPool& operator=(SmallObjectPool&& other) noexcept;
+	SmallObjectPool(size_t dataSize);
+	~SmallObjectPool() = default;
 
+	SmallObjectPool(SmallObjectPool&& other) = delete;
+	SmallObjectPool& operator=(SmallObjectPool&& other) = delete;
 	SmallObjectPool(const SmallObjectPool&) = delete;
 	SmallObjectPool& operator=(const SmallObjectPool&) = delete;
 
-	size_t GetMaxElementAmount() const { return m_OccupiedPlaces.size(); }
+	static SmallObjectPool* FromAddress(void* address) { return reinterpret_cast<SmallObjectPool*>(uintptr_t(address) & ~uintptr_t(SlabSize - 1)); }
+
+	size_t GetMaxElementAmount() const { return m_ElementAmount; }
 	size_t GetCurrentElementAmount() const { return GetMaxElementAmount() - m_FreeSpaces; }
 	size_t GetFreeSpaces() const { return m_FreeSpaces; }
 	bool contains(void* address) const;
-	size_t GetElementSize() const { return m_Size / m_OccupiedPlaces.size(); }
+	size_t GetElementSize() const { return m_ElementSize; }
 
 	void* allocate();
 	void deallocate(void* ptr);
@@ -34,58 +42,71 @@ public:
 	void* data() const { return m_Data; }
 
 	void* end() const;
+
 private:
 
+	// Every block has to be able to hold the pointer to the next free block
+	static constexpr size_t GetStride(size_t dataSize) { return dataSize < sizeof(void*) ? sizeof(void*) : dataSize; }
 
+	// The blocks start after the pool itself, rounded up to keep them 16 byte aligned
+	static constexpr size_t HeaderSize();
 
 private:
 
-	void* m_Data{};
-	size_t m_Size{};
-	void* m_NextFreeSpace{};
+	uint8_t* m_Data{};
+	size_t m_ElementSize{};
+	size_t m_ElementAmount{};
 
 	size_t m_FreeSpaces{};
-	std::vector<bool, Mallocator<bool>> m_OccupiedPlaces;
+	void* m_pFreeList{};
+	uint8_t* m_pUntouched{};
 };
 
-constexpr size_t CalculateTotalSize(size_t maxElementSize, size_t initialMaxSize, size_t x4, size_t x8)
-{
-	size_t total{};
-	for (size_t i{ 1 }; i <= maxElementSize; ++i)
-	{
-		size_t size = initialMaxSize;
-		size *= i & 0b11 ? 1 : x4;
-		size *= i & 0b111 ? 1 : x8;
-		size /= i;
-		total += size;
-	}
-	return total;
-}
-
+/**
+ * Thread safe allocator for objects up to 256 bytes.
+ * Every thread keeps a small cache of free blocks per size class so most allocations and deallocations don't lock.
+ * When a cache runs empty or full it is refilled or drained in batches from the shared pools under a single lock.
+ * Pools are created on demand, one aligned slab at a time. A radix map over the slab addresses tells if a pointer
+ * belongs to the allocator, so finding the owner of a pointer in the unsized delete is O(1).
+ */
 class SmallObjectAllocator final
 {
 	static constexpr size_t MaxElementSize{ 256 };
-	static constexpr size_t InitialMaxSize{ 256 };
-	static constexpr size_t Multiple4Multiplier{ 4 };
-	static constexpr size_t Multiple8Multiplier{ 4 };
-	static constexpr size_t CalculateTotalSize()
+	static constexpr size_t ThreadCacheSize{ 16 };
+	static constexpr size_t ThreadCacheBatchSize{ ThreadCacheSize / 2 };
+
+	// Radix map over the 47 bit user address space, one byte per slab
+	static constexpr size_t AddressBits{ 47 };
+	static constexpr size_t SlabBits{ 16 };
+	static constexpr size_t LeafBits{ 16 };
+	static constexpr size_t RootBits{ AddressBits - SlabBits - LeafBits };
+	static_assert(SmallObjectPool::SlabSize == size_t(1) << SlabBits);
+
+public:
+
+	struct ThreadCache final
 	{
-		size_t total{};
-		for (size_t i{ 1 }; i <= MaxElementSize; ++i)
+		struct Bin final
 		{
-			size_t size = InitialMaxSize;
-			size *= i & 0b11 ? 1 : Multiple4Multiplier;
-			size *= i & 0b111 ? 1 : Multiple8Multiplier;
-			size /= i;
-			size *= i;
-			total += size;
-		}
-		return total;
-	}
+			size_t count{};
+			void* blocks[ThreadCacheSize]{};
+		};
+
+		SmallObjectAllocator* pOwner{};
+		std::array<Bin, MaxElementSize> bins{};
+	};
 
 public:
 
-	SmallObjectAllocator();
+	SmallObjectAllocator() = default;
+
+	// The slabs are never returned, objects with static storage duration can still be deleted after the allocator
+	~SmallObjectAllocator() = default;
+
+	SmallObjectAllocator(const SmallObjectAllocator&) = delete;
+	SmallObjectAllocator(SmallObjectAllocator&&) = delete;
+	SmallObjectAllocator& operator=(const SmallObjectAllocator&) = delete;
+	SmallObjectAllocator& operator=(SmallObjectAllocator&&) = delete;
 
 	void* allocate(size_t count);
 
@@ -105,38 +126,41 @@ public:
 		deallocate(ptr, sizeof(T));
 	}
 
-	const auto& GetPools() const { return m_Pools; }
-
-	//const StackAllocator& GetStackAllocator() const { return m_StackAllocator; }
+	/** Returns the blocks in the cache of the calling thread to the shared pools.*/
+	void FlushThreadCache();
 
-private:
+	/** Lock this while reading the pools from a different thread than the one that allocates.*/
+	std::mutex& GetPoolMutex() const { return m_PoolMutex; }
 
-	void initialize();
+	const auto& GetPools() const { return m_Pools; }
 
 private:
 
-	//StackAllocator m_StackAllocator{ CalculateTotalSize() };
+	void* AllocateFromPools(size_t count);
+	void DeallocateToPools(void* ptr, size_t count);
+	SmallObjectPool* CreatePool(size_t count);
+	SmallObjectPool* FindPool(void* ptr) const;
 
-	std::array<std::vector<SmallObjectPool, Mallocator<SmallObjectPool>>, MaxElementSize> m_Pools;
+	ThreadCache* GetThreadCache();
+	void RefillBin(ThreadCache::Bin& bin, size_t count);
+	void DrainBin(ThreadCache::Bin& bin, size_t count, size_t amount);
 
 private:
 
-	struct AddressLookUp
-	{
-		void* address{};
-		size_t elementSize{};
-		void* poolEnd{};
-	};
+	// Guards the pools, taken when a thread cache needs a refill or is drained.
+	// Not recursive, nothing allocates through this allocator while holding it
+	mutable std::mutex m_PoolMutex;
 
-	struct AddressLookUpComp
-	{
-		bool operator()(const AddressLookUp& lhs, const AddressLookUp& rhs) const { return lhs.address < rhs.address; }
-	};
+	std::array<std::vector<SmallObjectPool*, Mallocator<SmallObjectPool*>>, MaxElementSize> m_Pools;
 
-	std::set<AddressLookUp, AddressLookUpComp, Mallocator<AddressLookUp>> m_AddressLookUpSet;
+	// Pools per size class that still have free space, the last one is used first
+	std::array<std::vector<SmallObjectPool*, Mallocator<SmallObjectPool*>>, MaxElementSize> m_AvailablePools;
 
+	// Only written while holding the pool mutex, read without locking in deallocate
+	std::array<std::atomic<uint8_t*>, size_t(1) << RootBits> m_SlabMap{};
 
 #ifdef _DEBUG
+	std::mutex m_MemoryAsserterMutex;
 	std::unordered_map<size_t, size_t, std::hash<size_t>, std::equal_to<size_t>, Mallocator<std::pair<const size_t, size_t>>> m_MemoryAsserter;
 #endif
-};
\ No newline at end of file
+};
@@ -2,6 +2,7 @@
 #include "StackAllocator.h"
 
 #include <cassert>
+#include <algorithm>
 
 StackAllocator::Stack::Stack(size_t size)
 {
@@ -43,14 +44,17 @@ bool StackAllocator::Stack::Fits(const uint8_t* ptr) const
 	return ptr < m_pStackStart + m_StackSize && ptr >= m_pStackStart;
 }
 
-bool StackAllocator::Stack::Fits(size_t size) const
+bool StackAllocator::Stack::Fits(size_t size, size_t alignment) const
 {
-	return size <= (GetStackSize() - GetHeight());
+	size_t padding = (alignment - uintptr_t(m_pStackPtr) % alignment) % alignment;
+	return size + padding <= (GetStackSize() - GetHeight());
 }
 
-void* StackAllocator::Stack::allocate(size_t size)
+void* StackAllocator::Stack::allocate(size_t size, size_t alignment)
 {
-	assert(Fits(size));
+	assert(Fits(size, alignment));
+
+	m_pStackPtr += (alignment - uintptr_t(m_pStackPtr) % alignment) % alignment;
 
 	auto returnValue = m_pStackPtr;
 	m_pStackPtr += size;
@@ -74,24 +78,34 @@ StackAllocator::StackAllocator(size_t stackSizes)
 	m_Stacks.emplace_back(stackSizes);
 }
 
-void* StackAllocator::allocate(const size_t memorySize)
+void* StackAllocator::allocate(const size_t memorySize, const size_t alignment)
 {
-	assert(memorySize <= m_Stacks.front().GetStackSize());
-
 	for (auto rIt{m_Stacks.rbegin()}; rIt != m_Stacks.rend(); ++rIt)
 	{
-		if (rIt->Fits(memorySize))
+		if (rIt->Fits(memorySize, alignment))
 		{
-			return rIt->allocate(memorySize);
+			return rIt->allocate(memorySize, alignment);
 		}
 	}
 
-	auto& stack = m_Stacks.emplace_back(m_Stacks.front().GetStackSize());
-	return stack.allocate(memorySize);
+	// Overflow, add a stack that is at least big enough for this allocation
+	++m_OverflowCount;
+	auto& stack = m_Stacks.emplace_back(std::max(m_Stacks.front().GetStackSize(), memorySize + alignment));
+	return stack.allocate(memorySize, alignment);
 }
 
 void StackAllocator::Reset()
 {
+	m_HighWaterMark = std::max(m_HighWaterMark, GetStackHeight());
+
+	if (m_Stacks.size() > 1)
+	{
+		size_t totalSize{ GetStackSize() };
+		m_Stacks.clear();
+		m_Stacks.emplace_back(totalSize);
+		return;
+	}
+
 	for (auto& stack : m_Stacks)
 	{
 		stack.Reset();
@@ -110,7 +124,12 @@ size_t StackAllocator::GetStackHeight() const
 
 size_t StackAllocator::GetStackSize() const
 {
-	return m_Stacks.size() * m_Stacks.front().GetStackSize();
+	size_t sum{};
+	for (auto& stack : m_Stacks)
+	{
+		sum += stack.GetStackSize();
+	}
+	return sum;
 }
 
 
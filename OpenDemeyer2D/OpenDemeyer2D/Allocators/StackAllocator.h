@@ -1,6 +1,8 @@
 ﻿#pragma once
 
 #include <cassert>
+#include <cstddef>
+#include <algorithm>
 #include <vector>
 #include "Mallocator.h"
 
@@ -28,8 +30,8 @@ class StackAllocator final
 		size_t GetHeight() const { return m_pStackPtr - m_pStackStart; }
 		size_t GetStackSize() const { return m_StackSize; }
 		bool Fits(const uint8_t* ptr) const;
-		bool Fits(size_t size) const;
-		void* allocate(size_t size);
+		bool Fits(size_t size, size_t alignment) const;
+		void* allocate(size_t size, size_t alignment);
 		void Reset();
 
 	private:
@@ -48,24 +50,37 @@ public:
 	StackAllocator& operator=(const StackAllocator&) = delete;
 	StackAllocator& operator=(StackAllocator&&) = delete;
 
-	void* allocate(const size_t memorySize);
+	void* allocate(const size_t memorySize, const size_t alignment = alignof(std::max_align_t));
 
+	/**
+	 * Releases all allocations at once.
+	 * When the previous use did not fit in one stack, the stacks are merged into one big enough for it.
+	 */
 	void Reset();
 	size_t GetStackHeight() const;
 	size_t GetStackSize() const;
 	const auto& GetStacks() const { return m_Stacks; }
 
+	/** Largest height reached between two resets since the allocator was created.*/
+	size_t GetHighWaterMark() const { return std::max(m_HighWaterMark, GetStackHeight()); }
+
+	/** Amount of times an allocation did not fit and an extra stack had to be added.*/
+	size_t GetOverflowCount() const { return m_OverflowCount; }
+
 	template <typename T>
 	T* allocate(const size_t amount = 1)
 	{
 		assert(amount);
-		return static_cast<T*>(allocate(sizeof(T) * amount));
+		return static_cast<T*>(allocate(sizeof(T) * amount, alignof(T)));
 	}
 
 private:
 	
 	std::vector<Stack, Mallocator<Stack>> m_Stacks{};
 
+	size_t m_HighWaterMark{};
+	size_t m_OverflowCount{};
+
 };
 
 
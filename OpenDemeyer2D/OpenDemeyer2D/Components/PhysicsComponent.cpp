@@ -479,11 +479,12 @@ void PhysicsComponent::CreateBody(b2BodyDef& def)
 	m_pBody = GetScene()->GetPhysicsInterface()->CreateBody(def);
 }
 
-std::vector<PhysicsComponent*> PhysicsComponent::GetOverlappingComponents()
+FrameVector<PhysicsComponent*> PhysicsComponent::GetOverlappingComponents()
 {
 	if (m_pBody)
 	{
-		return GetScene()->GetPhysicsInterface()->GetOverlappingComponents(this);
+		auto& overlapping = GetScene()->GetPhysicsInterface()->GetOverlappingComponents(this);
+		return FrameVector<PhysicsComponent*>(overlapping.begin(), overlapping.end());
 
 		/*b2AABB aabb{};
 		aabb.lowerBound = { b2_maxFloat, b2_maxFloat };
@@ -524,5 +525,5 @@ std::vector<PhysicsComponent*> PhysicsComponent::GetOverlappingComponents()
 		return overlappingFixtures;*/
 	}
 
-	return std::vector<PhysicsComponent*>();
+	return FrameVector<PhysicsComponent*>();
 }
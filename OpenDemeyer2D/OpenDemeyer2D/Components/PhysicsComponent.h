@@ -4,6 +4,7 @@
 
 #include "EngineFiles/ComponentBase.h"
 #include "UtilityFiles/Delegate.h"
+#include "Allocators/FrameAllocator.h"
 
 
 
@@ -60,7 +61,8 @@ public:
 
 	void CreateBody(b2BodyDef& def);
 
-	std::vector<PhysicsComponent*> GetOverlappingComponents();
+	/** The returned vector lives on the frame stack, don't keep it beyond the current frame.*/
+	FrameVector<PhysicsComponent*> GetOverlappingComponents();
 
 	//void Clone(const ComponentBase* pOriginal, CopyLinker* copyLinker = nullptr) override;
 
@@ -4,23 +4,71 @@
 #include "Transform.h"
 #include "EngineFiles/GameObject.h"
 #include "Singletons/RenderManager.h"
+#include "EngineFiles/RenderBoundsTree.h"
+#include "EngineFiles/Scene.h"
+#include "Singletons/SceneManager.h"
 #include "imgui.h"
 
 
+RenderComponent::~RenderComponent()
+{
+	if (IsInRenderedScene())
+		InvalidateRenderLayer();
+
+	if (m_pBoundsTree)
+		m_pBoundsTree->Destroy(this, m_BoundsProxy);
+}
+
+void RenderComponent::Initialize()
+{
+	// The fields get written directly when deserializing, they are final by now
+	if (IsInRenderedScene())
+		InvalidateRenderLayer();
+}
+
 void RenderComponent::DefineUserFields(UserFieldBinder& binder) const
 {
 	binder.Add<SDL_FRect>("sourceRect", offsetof(RenderComponent, m_SourceRect));
 	binder.Add<glm::vec2>("pivot", offsetof(RenderComponent, m_Pivot));
 	binder.Add<int>("renderLayer", offsetof(RenderComponent, m_RenderLayer));
+	binder.Add<int>("renderDepth", offsetof(RenderComponent, m_RenderDepth));
+	binder.Add<SDL_Color>("tint", offsetof(RenderComponent, m_Tint));
 }
 
-void RenderComponent::Render() const
+void RenderComponent::Render()
 {
+	// The texture is still being uploaded
+	if (m_Texture && !m_Texture->IsValid())
+		return;
+
+	// The texture was set before its size was known
+	if (m_Texture && !m_UsesQuads && m_SourceRect.w == 0 && m_SourceRect.h == 0)
+		ResetSourceRect();
+
+	// The layer keeps the previous frame, nothing to submit
+	if (!RENDER.IsRenderLayerRedrawn(m_RenderLayer) || !IsVisible())
+		return;
+
 	auto transform = GetTransform();
-	if (m_Texture && transform)
+	if (!m_Texture || !transform)
+		return;
+
+	if (!m_UsesQuads)
+	{
+		RENDER.RenderTexture(m_Texture, transform->GetWorldPosition(), transform->GetWorldScale(), transform->GetWorldRotation(),
+			m_Pivot, &m_SourceRect, m_RenderLayer, m_RenderDepth, m_Tint);
+		return;
+	}
+
+	// Every quad shares the transform of the component, the offset is moved into the pivot of the quad
+	const glm::vec2 size{ m_SourceRect.w, m_SourceRect.h };
+	for (auto& quad : m_Quads)
 	{
+		const glm::vec2 quadSize{ quad.sourceRect.w, quad.sourceRect.h };
+		const glm::vec2 pivot{ ((m_Pivot - 1.f) * size + quad.offset) / quadSize + 1.f };
+
 		RENDER.RenderTexture(m_Texture, transform->GetWorldPosition(), transform->GetWorldScale(), transform->GetWorldRotation(),
-			m_Pivot, &m_SourceRect, m_RenderLayer);
+			pivot, &quad.sourceRect, m_RenderLayer, m_RenderDepth, m_Tint);
 	}
 }
 
@@ -30,6 +78,9 @@ void RenderComponent::SetTexture(std::shared_ptr<Texture2D> texture)
 
 	if (m_SourceRect.h == 0 && m_SourceRect.w == 0 && m_Texture)	
 		m_SourceRect = SDL_FRect{ 0.f,0.f,float(texture->GetWidth()),float(texture->GetHeight()) };
+
+	InvalidateRenderLayer();
+	SetBoundsDirty();
 }
 
 void RenderComponent::SetRenderAlignMode(eRenderAlignMode mode)
@@ -64,30 +115,109 @@ void RenderComponent::SetRenderAlignMode(eRenderAlignMode mode)
 		m_Pivot.x = 0;
 		break;
 	}
+
+	InvalidateRenderLayer();
+	SetBoundsDirty();
 }
 
 void RenderComponent::SetSourceRect(const SDL_FRect& srcRect)
 {
 	m_SourceRect = srcRect;
+	InvalidateRenderLayer();
+	SetBoundsDirty();
 }
 
 void RenderComponent::ResetSourceRect()
 {
 	if (m_Texture)
 		m_SourceRect = { 0,0,float(m_Texture->GetWidth()), float(m_Texture->GetHeight()) };
+	InvalidateRenderLayer();
+	SetBoundsDirty();
+}
+
+void RenderComponent::SetPivot(const glm::vec2& pivot)
+{
+	m_Pivot = pivot;
+	InvalidateRenderLayer();
+	SetBoundsDirty();
+}
+
+void RenderComponent::SetRenderLayer(int renderLayer)
+{
+	InvalidateRenderLayer();
+	m_RenderLayer = renderLayer;
+	InvalidateRenderLayer();
+}
+
+void RenderComponent::SetRenderDepth(int depth)
+{
+	m_RenderDepth = depth;
+	InvalidateRenderLayer();
+}
+
+void RenderComponent::SetTint(const SDL_Color& tint)
+{
+	m_Tint = tint;
+	InvalidateRenderLayer();
+}
+
+void RenderComponent::SetQuads(const RenderQuad* pQuads, size_t amount)
+{
+	m_Quads.assign(pQuads, pQuads + amount);
+	m_UsesQuads = true;
+	InvalidateRenderLayer();
+}
+
+void RenderComponent::ClearQuads()
+{
+	m_Quads.clear();
+	m_UsesQuads = false;
+	InvalidateRenderLayer();
+}
+
+void RenderComponent::OnTransformChanged()
+{
+	InvalidateRenderLayer();
+	SetBoundsDirty();
+}
+
+bool RenderComponent::IsVisible() const
+{
+	return !m_pBoundsTree || m_VisibleFrame == m_pBoundsTree->GetFrame();
+}
+
+bool RenderComponent::IsInRenderedScene() const
+{
+	Scene* pScene{ SCENES.GetActiveScene() };
+	return m_pBoundsTree && pScene && m_pBoundsTree == &pScene->GetRenderBoundsTree();
+}
+
+void RenderComponent::BindBoundsTree(RenderBoundsTree* pTree)
+{
+	m_pBoundsTree = pTree;
+	m_BoundsProxy = pTree->Create(this);
+
+	// The fields may have been written directly when deserializing
+	SetBoundsDirty();
+}
+
+void RenderComponent::SetBoundsDirty()
+{
+	if (m_pBoundsTree)
+		m_pBoundsTree->SetDirty(this);
 }
 
 void RenderComponent::RenderImGui()
 {
 	// Show texture
-	if (m_Texture)
+	if (m_Texture && m_Texture->IsValid())
 	{
 		float ratio = float(m_Texture->GetWidth()) / float(m_Texture->GetHeight());
 
-		ImVec2 uv0 = { m_SourceRect.x / m_Texture->GetWidth(), m_SourceRect.y / m_Texture->GetHeight() };
-		ImVec2 uv1 = { m_SourceRect.w / m_Texture->GetWidth(), m_SourceRect.h / m_Texture->GetHeight() };
-		uv1.x += uv0.x;
-		uv1.y += uv0.y;
+		glm::vec2 pageUV0 = m_Texture->GetPageUV({ m_SourceRect.x, m_SourceRect.y });
+		glm::vec2 pageUV1 = m_Texture->GetPageUV({ m_SourceRect.x + m_SourceRect.w, m_SourceRect.y + m_SourceRect.h });
+		ImVec2 uv0 = { pageUV0.x, pageUV0.y };
+		ImVec2 uv1 = { pageUV1.x, pageUV1.y };
 
 		float width = ImGui::GetWindowWidth();
 
@@ -111,13 +241,23 @@ void RenderComponent::RenderImGui()
 
 	// Pivot
 	float dims[2]{ m_Pivot.x, m_Pivot.y };
-	ImGui::InputFloat2("Pivot", dims);
-
-	m_Pivot.x = dims[0];
-	m_Pivot.y = dims[1];
+	if (ImGui::InputFloat2("Pivot", dims))
+		SetPivot({ dims[0], dims[1] });
 
 	// Render Layer
-	ImGui::SliderInt("Render Layer", &m_RenderLayer, 0, int(RENDER.GetRenderLayersAmount()) - 1);
+	int renderLayer{ m_RenderLayer };
+	if (ImGui::SliderInt("Render Layer", &renderLayer, 0, int(RENDER.GetRenderLayersAmount()) - 1))
+		SetRenderLayer(renderLayer);
+
+	// Render Depth
+	int renderDepth{ m_RenderDepth };
+	if (ImGui::InputInt("Render Depth", &renderDepth))
+		SetRenderDepth(renderDepth);
+
+	// Tint
+	float colors[4]{ m_Tint.r / 255.f, m_Tint.g / 255.f, m_Tint.b / 255.f, m_Tint.a / 255.f };
+	if (ImGui::ColorEdit4("Tint", colors))
+		SetTint({ Uint8(colors[0] * 255.f), Uint8(colors[1] * 255.f), Uint8(colors[2] * 255.f), Uint8(colors[3] * 255.f) });
 
 	// Render Align modes
 	const char* items[] = { "Top Left", "Top Right", "Bottom Left", "Bottom Right", "Top", "Bottom", "Right", "Left", "Centered" };
@@ -4,23 +4,27 @@
 #include "Singletons/RenderManager.h"
 
 class Transform;
+class RenderBoundsTree;
 
 class RenderComponent final : public ComponentBase
 {
 	COMPONENT_BODY(RenderComponent)
 
+	friend class GameObject;
+	friend class RenderBoundsTree;
+
 public:
 
 	RenderComponent() = default;
-	virtual ~RenderComponent() = default;
+	virtual ~RenderComponent();
 
 public:
 
 	virtual void DefineUserFields(UserFieldBinder& binder) const;
 
-	void Render() const;
+	void Render();
 
-	//void Initialize() override;
+	void Initialize() override;
 
 	void SetTexture(std::shared_ptr<Texture2D> texture);
 
@@ -34,15 +38,54 @@ public:
 
 	void RenderImGui() override;
 
-	void SetPivot(const glm::vec2& pivot) { m_Pivot = pivot; }
+	void SetPivot(const glm::vec2& pivot);
 
-	void SetRenderLayer(int renderLayer) { m_RenderLayer = renderLayer; }
+	void SetRenderLayer(int renderLayer);
 
 	int GetRenderLayer() const { return m_RenderLayer; }
 
+	/** Sprites with a lower depth are drawn first inside their render layer.*/
+	void SetRenderDepth(int depth);
+
+	int GetRenderDepth() const { return m_RenderDepth; }
+
+	/** The color of the texture is multiplied with the tint.*/
+	void SetTint(const SDL_Color& tint);
+
+	const SDL_Color& GetTint() const { return m_Tint; }
+
+	/**
+	 * Draws the quads instead of the source rectangle, used to draw text from a glyph sheet.
+	 * The source rectangle then only gives the size of the area the quads are laid out in, for the pivot and the bounds.
+	 * The quads are copied into storage that is reused between calls.
+	 */
+	void SetQuads(const RenderQuad* pQuads, size_t amount);
+
+	/** Draws the source rectangle again.*/
+	void ClearQuads();
+
 	// array to 4 vec2 that will be filled with the vertex positions
 	glm::vec2* GetWorldRect(glm::vec2* vertices4) const;
 
+	/** Makes a static render layer redraw, call after changing anything that changes how this component looks.*/
+	void InvalidateRenderLayer() const { RENDER.InvalidateRenderLayer(m_RenderLayer); }
+
+	/** Gets called by the transform when its world values change.*/
+	void OnTransformChanged();
+
+	/** False when the bounds of this component did not overlap the view the last time the scene was culled.*/
+	bool IsVisible() const;
+
+private:
+
+	/** Adds the bounds of this component to the tree of the scene. Gets called by the GameObject that owns it.*/
+	void BindBoundsTree(RenderBoundsTree* pTree);
+
+	void SetBoundsDirty();
+
+	/** True when the component belongs to the scene that is being rendered, only that scene draws on the render layers.*/
+	bool IsInRenderedScene() const;
+
 private:
 
 	std::shared_ptr<Texture2D> m_Texture;
@@ -53,4 +96,16 @@ private:
 
 	int m_RenderLayer{};
 
+	int m_RenderDepth{};
+
+	SDL_Color m_Tint{ 255,255,255,255 };
+
+	std::vector<RenderQuad> m_Quads;
+	bool m_UsesQuads{};
+
+	RenderBoundsTree* m_pBoundsTree{};
+	int32_t m_BoundsProxy{ -1 };
+	uint32_t m_VisibleFrame{};
+	bool m_IsBoundsDirty{};
+
 };
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include "RenderComponent.h"
 #include "ResourceWrappers/Font.h"
+#include "ResourceWrappers/Texture2D.h"
+#include "Allocators/FrameAllocator.h"
 #include "Singletons/ResourceManager.h"
 #include "imgui.h"
 
@@ -11,30 +13,13 @@ void TextComponent::Update(float)
 {
 	if (m_NeedsUpdate)
 	{
-		//const auto surf = TTF_RenderText_Blended(m_Font->GetFont(), m_Text.c_str(), m_Color);
-		//if (surf == nullptr)
-		//{
-		//	throw std::runtime_error(std::string("Render text failed: ") + SDL_GetError());
-		//}
-		//
-		//m_TextTexture = RESOURCES.LoadTexture(surf);
-		//
-		//SDL_FreeSurface(surf);
-		//
-		//m_NeedsUpdate = false;
-		//
-		//if (m_pRenderComp)
-		//{
-		//	m_pRenderComp->SetTexture(m_TextTexture);
-		//}
+		UpdateText();
 	}
 }
 
 void TextComponent::Initialize()
 {
-	//m_pRenderComp = GetParent()->GetComponent<RenderComponent>();
-	//
-	//if (m_pRenderComp && m_TextTexture) m_pRenderComp->SetTexture(m_TextTexture);
+	UpdateText();
 }
 
 void TextComponent::SetFont(const std::shared_ptr<Font>& font)
@@ -45,6 +30,9 @@ void TextComponent::SetFont(const std::shared_ptr<Font>& font)
 
 void TextComponent::SetText(const std::string& text)
 {
+	if (m_Text == text)
+		return;
+
 	m_Text = text;
 	m_NeedsUpdate = true;
 }
@@ -52,19 +40,46 @@ void TextComponent::SetText(const std::string& text)
 void TextComponent::SetColor(const SDL_Color& color)
 {
 	m_Color = color;
-	m_NeedsUpdate = true;
+
+	// Only the tint changes, the layout stays the same
+	if (auto render = GetRenderComponent())
+		render->SetTint(m_Color);
 }
 
 void TextComponent::SetSize(unsigned size)
 {
-	if (m_Font->GetSize() != size)
+	if (m_Font && m_Font->GetSize() != size && size > 0)
 	{
-		//TODO
-		//m_Font = RESOURCES.LoadFont(m_Font->GetPath(), size);
+		m_Font = RESOURCES.LoadFont(m_Font->GetPath(), size);
 		m_NeedsUpdate = true;
 	}
 }
 
+void TextComponent::UpdateText()
+{
+	auto render = GetRenderComponent();
+	if (!render || !m_Font)
+		return;
+
+	auto& glyphCache = m_Font->GetGlyphCache();
+
+	// The layout only lives until it is copied into the render component
+	FrameVector<RenderQuad> glyphs{};
+	glyphs.reserve(m_Text.size());
+
+	const glm::vec2 size{ glyphCache.Layout(m_Text, glyphs) };
+
+	if (render->GetTexture() != glyphCache.GetTexture())
+		render->SetTexture(glyphCache.GetTexture());
+
+	// The source rectangle is the size of the whole text, so the pivot and the bounds apply to all of it
+	render->SetSourceRect({ 0.f, 0.f, size.x, size.y });
+	render->SetQuads(glyphs.data(), glyphs.size());
+	render->SetTint(m_Color);
+
+	m_NeedsUpdate = false;
+}
+
 void TextComponent::RenderImGui()
 {
 	// Change text
@@ -75,6 +90,7 @@ void TextComponent::RenderImGui()
 	if (m_Text != std::string(buffer))
 	{
 		SetText(std::string(buffer));
+		UpdateText();
 	}
 
 	// Change Color
@@ -86,6 +102,9 @@ void TextComponent::RenderImGui()
 		SetColor({ Uint8(colors[0] * 255.f),Uint8(colors[1] * 255.f) ,Uint8(colors[2] * 255.f) ,Uint8(colors[3] * 255.f) });
 	}
 
+	if (!m_Font)
+		return;
+
 	// Change Char Size
 	int fontSize = m_Font->GetSize();
 	ImGui::InputInt("Character Size", &fontSize);
@@ -93,5 +112,9 @@ void TextComponent::RenderImGui()
 	if (fontSize != int(m_Font->GetSize()))
 	{
 		SetSize(fontSize);
+		UpdateText();
 	}
+
+	auto& glyphCache = m_Font->GetGlyphCache();
+	ImGui::Text("Cached glyphs: %zd, Layouts: %zd", glyphCache.GetGlyphAmount(), glyphCache.GetLayoutCount());
 }
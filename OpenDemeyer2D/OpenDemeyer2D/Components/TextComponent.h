@@ -8,6 +8,10 @@ class Texture2D;
 class RenderComponent;
 class TextureComponent;
 
+/**
+ * Draws text with a TrueType font. The glyphs come from the glyph cache of the font
+ * and are drawn as quads of the render component, the color is applied as the tint.
+ */
 class TextComponent final : public ComponentBase
 {
 	COMPONENT_BODY(TextComponent)
@@ -35,6 +39,11 @@ public:
 
 	void RenderImGui() override;
 
+private:
+
+	/** Lays out the text on the render component.*/
+	void UpdateText();
+
 private:
 
 	bool m_NeedsUpdate{};
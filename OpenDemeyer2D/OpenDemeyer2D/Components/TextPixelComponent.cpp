@@ -4,6 +4,8 @@
 #include "Singletons/ResourceManager.h"
 #include "Singletons/RenderManager.h"
 #include "ResourceWrappers/Surface2D.h"
+#include "ResourceWrappers/Texture2D.h"
+#include "Allocators/FrameAllocator.h"
 
 #include "ImGuiExt/imgui_helpers.h"
 
@@ -19,23 +21,27 @@ void TextPixelComponent::Update(float)
 {
 	if (m_NeedsUpdate)
 	{
-		UpdateFontTexture();
+		UpdateText();
 	}
 }
 
 void TextPixelComponent::Initialize()
 {
-	UpdateFontTexture();
+	UpdateText();
 }
 
 void TextPixelComponent::setFontTexture(const std::shared_ptr<Surface2D>& surface)
 {
 	m_FontSurface = surface;
+	m_NeedsFontUpdate = true;
 	m_NeedsUpdate = true;
 }
 
 void TextPixelComponent::SetText(const std::string& text)
 {
+	if (m_Text == text)
+		return;
+
 	m_Text = text;
 	m_NeedsUpdate = true;
 }
@@ -43,7 +49,10 @@ void TextPixelComponent::SetText(const std::string& text)
 void TextPixelComponent::SetColor(const SDL_Color& color)
 {
 	m_Color = color;
-	m_NeedsUpdate = true;
+
+	// Only the tint changes, the layout stays the same
+	if (auto render = GetRenderComponent())
+		render->SetTint(m_Color);
 }
 
 void TextPixelComponent::SetCharPixelSize(int size)
@@ -62,7 +71,7 @@ void TextPixelComponent::RenderImGui()
 	if (m_Text != std::string(buffer))
 	{
 		SetText(std::string(buffer));
-		UpdateFontTexture();
+		UpdateText();
 	}
 
 	// Change Color
@@ -72,91 +81,74 @@ void TextPixelComponent::RenderImGui()
 	if (colors[0] != m_Color.r / 255.f || colors[1] != m_Color.g / 255.f || colors[2] != m_Color.b / 255.f || colors[3] != m_Color.a / 255.f)
 	{
 		SetColor({ Uint8(colors[0] * 255.f),Uint8(colors[1] * 255.f) ,Uint8(colors[2] * 255.f) ,Uint8(colors[3] * 255.f) });
-		UpdateFontTexture();
 	}
 
 	// Change Char Size
 	int charSize = m_CharSize;
 	ImGui::InputInt("Character Size", &charSize);
 
-	if (charSize != m_CharSize)
+	if (charSize != m_CharSize && charSize > 0)
 	{
-		m_CharSize = charSize;
-		UpdateFontTexture();
+		SetCharPixelSize(charSize);
+		UpdateText();
 	}
 
 	// Change Font Surface
+	auto pFontSurface = m_FontSurface;
 	ImGui::ResourceSelect("FontSurface", m_FontSurface);
 
+	if (pFontSurface != m_FontSurface)
+	{
+		m_NeedsFontUpdate = true;
+		UpdateText();
+	}
+
 	if (ImGui::Button("Refresh"))
 	{
-		UpdateFontTexture();
+		m_NeedsFontUpdate = true;
+		UpdateText();
 	}
 }
 
-void TextPixelComponent::UpdateFontTexture()
+void TextPixelComponent::UpdateText()
 {
-	if (!GetRenderComponent() || !m_FontSurface)
+	auto render = GetRenderComponent();
+	if (!render || !m_FontSurface || !m_FontSurface->GetSurface() || m_CharSize <= 0)
 		return;
 
+	if (m_NeedsFontUpdate)
+		UpdateFontTexture();
 
-	size_t textSize = m_Text.size();
-
-	// create an empty surface
-	auto pSurface = SDL_CreateRGBSurfaceWithFormat(0, int(textSize) * m_CharSize, m_CharSize, 32, SDL_PIXELFORMAT_RGBA32);
-	if (!pSurface)
-	{
-		throw std::runtime_error(std::string("Failed to create surface: ") + SDL_GetError());
-	}
-
-	SDL_Rect fontSource{ 0,0,m_CharSize,m_CharSize };
-	SDL_Rect destinationSource{ 0,0,m_CharSize,m_CharSize };
+	const int characterPerLine{ std::max(m_FontSurface->GetSurface()->w / m_CharSize, 1) };
+	const float charSize{ float(m_CharSize) };
 
-	int characterPerLine = m_FontSurface->GetSurface()->w / m_CharSize;
+	// The layout only lives until it is copied into the render component
+	FrameVector<RenderQuad> glyphs{};
+	glyphs.reserve(m_Text.size());
 
-	for (size_t i{}; i < textSize; ++i)
+	for (size_t i{}; i < m_Text.size(); ++i)
 	{
-		auto character = m_Text[i];
+		const int character{ m_Text[i] - 32 }; // remove the first 32 whitespaces
 
-		character -= 32; // remove the first 32 whitespaces
-
-		fontSource.x = (character % characterPerLine) * m_CharSize;
-		fontSource.y = (character / characterPerLine) * m_CharSize;
-
-		destinationSource.x = int(i) * m_CharSize;
-
-		SDL_BlitSurface(
-			m_FontSurface->GetSurface(),
-			&fontSource,
-			pSurface,
-			&destinationSource
-		);
+		glyphs.emplace_back(RenderQuad{
+			SDL_FRect{ float((character % characterPerLine) * m_CharSize), float((character / characterPerLine) * m_CharSize), charSize, charSize },
+			glm::vec2{ float(i) * charSize, 0.f } });
 	}
 
-	// Change the color of each pixel
-	{
-		float colorR = float(m_Color.r) / 255.f;
-		float colorG = float(m_Color.g) / 255.f;
-		float colorB = float(m_Color.b) / 255.f;
-		float colorA = float(m_Color.a) / 255.f;
-
-		const size_t amountOfPixel{ size_t(pSurface->w * pSurface->h) };
-		Uint8* pixelsCol = static_cast<Uint8*>(pSurface->pixels);
-		for (size_t i{}; i < amountOfPixel * 4; i += 4)
-		{
-			pixelsCol[i] = Uint8(float(pixelsCol[i]) * colorR);
-			pixelsCol[i + 1] = Uint8(float(pixelsCol[i + 1]) * colorG);
-			pixelsCol[i + 2] = Uint8(float(pixelsCol[i + 2]) * colorB);
-			pixelsCol[i + 3] = Uint8(float(pixelsCol[i + 3]) * colorA);
-		}
-	}
+	// The source rectangle is the size of the whole text, so the pivot and the bounds apply to all of it
+	render->SetSourceRect({ 0.f, 0.f, float(m_Text.size()) * charSize, charSize });
+	render->SetQuads(glyphs.data(), glyphs.size());
+	render->SetTint(m_Color);
 
-	auto render = GetRenderComponent();
-	render->SetTexture(RESOURCES.LoadTexture(pSurface));
-	render->ResetSourceRect();
+	m_NeedsUpdate = false;
+}
 
-	SDL_FreeSurface(pSurface);
+void TextPixelComponent::UpdateFontTexture()
+{
+	const auto& file = m_FontSurface->GetFilePath();
+	m_FontTexture = file.empty() ? RESOURCES.LoadTexture(m_FontSurface->GetSurface()) : RESOURCES.LoadTexture(file);
 
-	m_NeedsUpdate = false;
+	GetRenderComponent()->SetTexture(m_FontTexture);
 
+	m_NeedsFontUpdate = false;
 }
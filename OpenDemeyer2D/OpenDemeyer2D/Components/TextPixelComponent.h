@@ -9,6 +9,11 @@ class Texture2D;
 class RenderComponent;
 class TextureComponent;
 
+/**
+ * Draws text from a font sheet of fixed size characters, starting at the space character.
+ * Every character is drawn as a quad of the render component straight from the font texture,
+ * so changing the text only rebuilds the layout and the color is applied as the tint.
+ */
 class TextPixelComponent final : public ComponentBase
 {
 	COMPONENT_BODY(TextPixelComponent)
@@ -41,14 +46,20 @@ public:
 
 private:
 
+	/** Lays out the characters of the text on the render component.*/
+	void UpdateText();
+
+	/** Gets the GL texture of the font surface, the texture is shared when the surface was loaded from a file.*/
 	void UpdateFontTexture();
 
 private:
 
 	bool m_NeedsUpdate{};
+	bool m_NeedsFontUpdate{ true };
 
 	std::string m_Text;
 	std::shared_ptr<Surface2D> m_FontSurface;
+	std::shared_ptr<Texture2D> m_FontTexture;
 	SDL_Color m_Color{ 255,255,255,255 };
 	int m_CharSize{ 8 };
 };
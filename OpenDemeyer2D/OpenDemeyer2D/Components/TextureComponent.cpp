@@ -32,9 +32,11 @@ void TextureComponent::RenderImGui()
 	{
 		float width = ImGui::GetWindowSize().x - 20.f;
 		float aspectRatio = float(m_Texture->GetWidth()) / float(m_Texture->GetHeight());
+		glm::vec2 uv0 = m_Texture->GetPageUV({ 0.f, 0.f });
+		glm::vec2 uv1 = m_Texture->GetPageUV({ m_Texture->GetWidth(), m_Texture->GetHeight() });
 
 #pragma warning(disable : 4312)
-		ImGui::Image((ImTextureID)(m_Texture->GetId()), { width,width / aspectRatio });
+		ImGui::Image((ImTextureID)(m_Texture->GetId()), { width,width / aspectRatio }, { uv0.x, uv0.y }, { uv1.x, uv1.y });
 #pragma warning(default : 4312)
 
 		UpdateRenderComponent();
@@ -2,10 +2,17 @@
 #include "Transform.h"
 
 #include "EngineFiles/GameObject.h"
+#include "Components/RenderComponent.h"
 #include "imgui.h"
 #include "UtilityFiles/Dictionary.h"
 
 
+Transform::~Transform()
+{
+	if (m_pStore)
+		m_pStore->Destroy(m_Handle);
+}
+
 void Transform::DefineUserFields(UserFieldBinder& binder) const
 {
 	binder.Add<glm::vec2>("position", offsetof(Transform, m_LocalPosition));
@@ -15,7 +22,7 @@ void Transform::DefineUserFields(UserFieldBinder& binder) const
 
 void Transform::Initialize()
 {
-	UpdateLocalChanges();
+	SetWorldDirty();
 }
 
 void Transform::RenderImGui()
@@ -46,9 +53,11 @@ void Transform::RenderImGui()
 		SetRotation(rotation);
 
 	// Display world transforms
-	ImGui::Text("World Position: [%.1f,%.1f]", m_Position.x, m_Position.y);
-	ImGui::Text("World Scale:    [%.1f,%.1f]", m_Scale.x, m_Scale.y);
-	ImGui::Text("World Rotation: [%.1f]", m_Rotation);
+	auto& worldPosition = GetWorldPosition();
+	auto& worldScale = GetWorldScale();
+	ImGui::Text("World Position: [%.1f,%.1f]", worldPosition.x, worldPosition.y);
+	ImGui::Text("World Scale:    [%.1f,%.1f]", worldScale.x, worldScale.y);
+	ImGui::Text("World Rotation: [%.1f]", GetWorldRotation());
 }
 
 
@@ -75,121 +84,66 @@ void Transform::SetRotation(float rotation)
 void Transform::Move(const glm::vec2& distance)
 {
 	m_LocalPosition += distance;
-	UpdateLocalChanges();
+	SetWorldDirty();
 }
 
 void Transform::Scale(const glm::vec2& scalar)
 {
 	m_LocalScale *= scalar;
-	UpdateLocalChanges();
+	SetWorldDirty();
 }
 
 void Transform::Rotate(float rotation)
 {
 	m_LocalRotation += rotation;
-	UpdateLocalChanges();
+	SetWorldDirty();
 }
 
-void Transform::UpdateLocalChanges()
+void Transform::SetWorldDirty()
 {
-	m_localTransformation = TransformationMatrix(m_LocalPosition, m_LocalScale, m_LocalRotation);
-	if (GameObject * pParent{ GetGameObject()->GetParent() }) {
-		m_Transformation = m_localTransformation * pParent->GetTransform()->m_Transformation;
-		m_Position = GetPosFromMat(m_Transformation);
-		m_Scale = GetScaleFromMat(m_Transformation);
-		m_Rotation = GetRotationFromMat(m_Transformation);
-	}
-	else
-	{
-		m_Transformation = m_localTransformation;
-		m_Position = m_LocalPosition;
-		m_Scale = m_LocalScale;
-		m_Rotation = m_LocalRotation;
-	}
+	m_pStore->SetLocal(m_Handle, m_LocalPosition, m_LocalScale, m_LocalRotation);
+	NotifyRenderComponent();
+
+	// The children of a dirty transform are already dirty, so repeated changes stay cheap
+	if (!m_pStore->SetDirty(m_Handle))
+		return;
 
 	for (GameObject* child : GetGameObject()->GetChildren())
-		child->GetTransform()->ApplyMatrix(m_Transformation);
+		child->GetTransform()->MarkDirty();
 }
 
-void Transform::Scale(float scale) { Scale({ scale, scale }); }
-
-void Transform::AddScale(const glm::vec2& scale){ Scale({ (m_Scale + scale) / m_Scale }); }
-
-void Transform::AddScale(float scale){ AddScale({ scale,scale }); }
-
-void Transform::ApplyMatrix(const glm::mat3x3& matrix)
+void Transform::MarkDirty()
 {
-	m_Transformation = m_localTransformation * matrix;
-	m_Position = GetPosFromMat(m_Transformation);
-	m_Scale = GetScaleFromMat(m_Transformation);
-	m_Rotation = GetRotationFromMat(m_Transformation);
-
-	for (GameObject* pObject : GetGameObject()->GetChildren())
-	{
-		pObject->GetTransform()->ApplyMatrix(m_Transformation);
-	}
-}
+	if (!m_pStore->SetDirty(m_Handle))
+		return;
 
-glm::vec2 GetPosFromMat(const glm::mat3x3& matrix)
-{
-	return { matrix[0][2], matrix[1][2] };
-}
+	NotifyRenderComponent();
 
-glm::vec2 GetScaleFromMat(const glm::mat3x3& matrix)
-{
-	const float SquareSum0 = (matrix[0][0] * matrix[0][0]) + (matrix[1][0] * matrix[1][0]);
-	const float SquareSum1 = (matrix[0][1] * matrix[0][1]) + (matrix[1][1] * matrix[1][1]);
-
-	return
-	{	glm::sign(matrix[0][0]) * glm::sqrt(SquareSum0),
-		glm::sign(matrix[1][1]) * glm::sqrt(SquareSum1) };
+	for (GameObject* child : GetGameObject()->GetChildren())
+		child->GetTransform()->MarkDirty();
 }
 
-float GetRotationFromMat(const glm::mat3x3& matrix)
+void Transform::NotifyRenderComponent() const
 {
-	constexpr float toRadian{ 1.f * 180.f / float(M_PI) };
-
-	return atan2(matrix[1][0], matrix[1][1]) * toRadian;
+	if (auto pRenderComponent = GetGameObject()->GetRenderComponent())
+		pRenderComponent->OnTransformChanged();
 }
 
-glm::mat3x3 TranslationMatrix(const glm::vec2& translation)
+void Transform::UpdateParent()
 {
-	return glm::mat3x3{
-		0,0,translation.x,
-		0,0,translation.y,
-		0,0,1
-	};
+	GameObject* pParent{ GetGameObject()->GetParent() };
+	m_pStore->SetParent(m_Handle, pParent ? pParent->GetTransform()->m_Handle : TransformStore::InvalidHandle);
+	MarkDirty();
 }
 
-glm::mat3x3 ScaleMatrix(const glm::vec2& scale)
+void Transform::BindStore(TransformStore* pStore)
 {
-	return glm::mat3x3{
-		scale.x,0,0,
-		0,scale.y,0,
-		0,0,1
-	};
+	m_pStore = pStore;
+	m_Handle = pStore->Create();
 }
 
-glm::mat3x3 RotationMatrix(float rotation)
-{
-	float cosAngle{ cos(rotation) };
-	float sinAngle{ sin(rotation) };
-	return{
-		cosAngle, -sinAngle, 0,
-		sinAngle, cosAngle,0,
-		0,0,1
-	};
-}
+void Transform::Scale(float scale) { Scale({ scale, scale }); }
 
-glm::mat3x3 TransformationMatrix(const glm::vec2& pos, const glm::vec2& scale, float rotation)
-{
-	constexpr float inverse180{ 1.f / 180.f * float(M_PI) };
-
-	float cosAngle{ cos(rotation * inverse180) };
-	float sinAngle{ sin(rotation * inverse180) };
-	return glm::mat3x3{
-		scale.x * cosAngle, -sinAngle * scale.x, pos.x,
-		scale.y * sinAngle, scale.y * cosAngle, pos.y,
-		0,0,1
-	};
-}
+void Transform::AddScale(const glm::vec2& scale){ Scale({ (GetWorldScale() + scale) / GetWorldScale() }); }
+
+void Transform::AddScale(float scale){ AddScale({ scale,scale }); }
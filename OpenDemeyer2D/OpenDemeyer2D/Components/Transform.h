@@ -1,14 +1,21 @@
 #pragma once
 #include "EngineFiles/ComponentBase.h"
+#include "EngineFiles/TransformStore.h"
 
+/**
+ * Handle into the TransformStore of the scene.
+ * The local values are kept in the component so they can be serialized, the world values only live in the store.
+ */
 class Transform final : public ComponentBase
 {
 	COMPONENT_BODY(Transform)
 
+	friend class GameObject;
+
 public:
 
 	Transform() = default;
-	virtual ~Transform() = default;
+	virtual ~Transform();
 
 public:
 	
@@ -18,14 +25,14 @@ public:
 
 	void DefineUserFields(UserFieldBinder&) const override;
 
-	const glm::vec2& GetWorldPosition() const { return m_Position; }
+	const glm::vec2& GetWorldPosition() const { return m_pStore->GetWorldPosition(m_Handle); }
 
 	const glm::vec2& GetLocalPosition() const { return m_LocalPosition; }
 
 	/** Sets the position of the transform and change the position of the children of the parent*/
 	void SetPosition(const glm::vec2& pos);
 
-	const glm::vec2& GetWorldScale() const { return m_Scale; }
+	const glm::vec2& GetWorldScale() const { return m_pStore->GetWorldScale(m_Handle); }
 
 	const glm::vec2& GetLocalScale() const { return m_LocalScale; }
 
@@ -51,52 +58,36 @@ public:
 
 	void Rotate(float rotation);
 
-	float GetWorldRotation() const { return m_Rotation; }
+	float GetWorldRotation() const { return m_pStore->GetWorldRotation(m_Handle); }
 
 	float GetLocalRotation() const { return m_LocalRotation; }
 
-	void ApplyMatrix(const glm::mat3x3& matrix);
-
-private:
-
 	/**
-	 * Call this function when local changes have been made
-	 * Will update the other values and its child game objects
+	 * Flags the world values of this transform and its children as out of date.
+ * They get recalculated the next time they are read or when the store gets updated at the end of the frame.
+	 * Gets called when local changes have been made.
 	 */
-	void UpdateLocalChanges();
+	void SetWorldDirty();
 
-	glm::vec2 m_Position{0,0};
-	glm::vec2 m_Scale{1,1};
-	float m_Rotation{ 0 };
-
-	glm::vec2 m_LocalPosition{ 0,0 };
-	glm::vec2 m_LocalScale{ 1,1 };
-	float m_LocalRotation{ 0 };
+	/** Links the transform to the transform of the parent game object. Gets called when the game object is reparented.*/
+	void UpdateParent();
 
-	glm::mat3x3 m_localTransformation{
-		1,0,0,
-		0,1,0,
-		0,0,1
-	};
-
-	glm::mat3x3 m_Transformation{
-		1,0,0,
-		0,1,0,
-		0,0,1
-	};
-
-};
-
-glm::vec2 GetPosFromMat(const glm::mat3x3& matrix);
+private:
 
-glm::vec2 GetScaleFromMat(const glm::mat3x3& matrix);
+	/** Flags this transform and its children as dirty without changing the local values*/
+	void MarkDirty();
 
-float GetRotationFromMat(const glm::mat3x3& matrix);
+	/** Lets the render component on this game object redraw its static render layer and update its bounds*/
+	void NotifyRenderComponent() const;
 
-glm::mat3x3 TranslationMatrix(const glm::vec2& translation);
+	/** Creates the transform in the store of the scene. Gets called by the GameObject that owns it.*/
+	void BindStore(TransformStore* pStore);
 
-glm::mat3x3 ScaleMatrix(const glm::vec2& scale);
+	glm::vec2 m_LocalPosition{ 0,0 };
+	glm::vec2 m_LocalScale{ 1,1 };
+	float m_LocalRotation{ 0 };
 
-glm::mat3x3 RotationMatrix(float rotation);
+	TransformStore* m_pStore{};
+	uint32_t m_Handle{ TransformStore::InvalidHandle };
 
-glm::mat3x3 TransformationMatrix(const glm::vec2& pos, const glm::vec2& scale, float rotation);
\ No newline at end of file
+};
\ No newline at end of file
@@ -16,6 +16,12 @@ class ComponentBase
 {
 
 	friend class GameObject;
+	friend class ComponentPoolBase;
+	friend class ComponentRegistry;
+	friend class GUIManager;
+
+	template <typename T>
+	friend class TypeIdentifier;
 
 protected:
 
@@ -74,10 +80,7 @@ public:
 
 		if (typeInfo)
 		{
-			for (auto field : typeInfo->field.GetFields())
-			{
-				field.second.Copy(pOriginal, this, copyLinker);
-			}
+			typeInfo->field.Copy(pOriginal, this, copyLinker);
 		}
 	}
 
@@ -111,6 +114,10 @@ private:
 
 	GameObject* m_pParent{};
 
+	/** The pool that stores this component and its index in the dense array of that pool*/
+	ComponentPoolBase* m_pPool{};
+	size_t m_PoolIndex{};
+
 protected:
 
 	/** Shared pointer with empty destructor for which you can ask a weak reference to*/
@@ -190,12 +197,7 @@ void CopyWeakPtr(const std::weak_ptr<T>& original, std::weak_ptr<T>& copy, CopyL
 	auto typeInfo = TypeInformation::GetInstance().GetTypeInfo(id);\
 	assert(typeInfo);\
 \
-	for (auto& field : typeInfo->field.GetFields())\
-	{\
-		os << field.first << ' ';\
-		field.second.Serialize(os, this);\
-		os << '\n';\
-	}\
+	typeInfo->field.Serialize(os, this);\
 }
 #define DeserializeFuncDef(TypeName) void Deserialize(Deserializer& is) override\
 {\
@@ -209,10 +211,9 @@ void CopyWeakPtr(const std::weak_ptr<T>& original, std::weak_ptr<T>& copy, CopyL
 		{\
 			std::string fieldName;\
 			*is.GetStream() >> fieldName;\
-			auto it = typeInfo->field.GetFields().find(fieldName);\
-			if (it != typeInfo->field.GetFields().end())\
+			if (auto pField = typeInfo->field.FindField(fieldName))\
 			{\
-				it->second.Deserialize(is, this);\
+				pField->Deserialize(is, this);\
 			}\
 		}\
 	}\
@@ -238,4 +239,5 @@ DeserializeFuncDef(TypeName)\
 MakeCopyFuncDef(TypeName)\
 GetWeakReferenceTypeFuncDef(TypeName)\
 private:\
+friend class ::TypeIdentifier<TypeName>;\
 inline static TypeIdentifier<TypeName> TypeIdentifier{};
\ No newline at end of file
@@ -0,0 +1,96 @@
+﻿#include "pch.h"
+#include "ComponentRegistry.h"
+
+#include "EngineFiles/ComponentBase.h"
+
+void ComponentPoolBase::Update(float deltaTime)
+{
+	m_IsUpdating = true;
+
+	// Indexed loop, components can be added while updating
+	for (size_t i{}; i < m_Components.size(); ++i)
+	{
+		ComponentBase* pComponent = m_Components[i];
+		if (pComponent && pComponent->GetGameObject()->HasBegunPlay())
+			pComponent->Update(deltaTime);
+	}
+
+	m_IsUpdating = false;
+	if (m_HasRemovedWhileUpdating) CompactComponents();
+}
+
+void ComponentPoolBase::LateUpdate()
+{
+	m_IsUpdating = true;
+
+	for (size_t i{}; i < m_Components.size(); ++i)
+	{
+		ComponentBase* pComponent = m_Components[i];
+		if (pComponent && pComponent->GetGameObject()->HasBegunPlay())
+			pComponent->LateUpdate();
+	}
+
+	m_IsUpdating = false;
+	if (m_HasRemovedWhileUpdating) CompactComponents();
+}
+
+void ComponentPoolBase::AddComponent(ComponentBase* pComponent)
+{
+	pComponent->m_pPool = this;
+	pComponent->m_PoolIndex = m_Components.size();
+	m_Components.emplace_back(pComponent);
+}
+
+void ComponentPoolBase::RemoveComponent(ComponentBase* pComponent)
+{
+	size_t index{ pComponent->m_PoolIndex };
+	assert(index < m_Components.size() && m_Components[index] == pComponent);
+
+	if (m_IsUpdating)
+	{
+		m_Components[index] = nullptr;
+		m_HasRemovedWhileUpdating = true;
+		return;
+	}
+
+	// Swap remove to keep the array dense
+	m_Components[index] = m_Components.back();
+	m_Components[index]->m_PoolIndex = index;
+	m_Components.pop_back();
+}
+
+void ComponentPoolBase::CompactComponents()
+{
+	size_t size{};
+	for (ComponentBase* pComponent : m_Components)
+	{
+		if (!pComponent) continue;
+		pComponent->m_PoolIndex = size;
+		m_Components[size++] = pComponent;
+	}
+	m_Components.resize(size);
+	m_HasRemovedWhileUpdating = false;
+}
+
+void ComponentRegistry::Destroy(ComponentBase* pComponent)
+{
+	assert(pComponent->m_pPool);
+	pComponent->m_pPool->Destroy(pComponent);
+}
+
+void ComponentRegistry::Update(float deltaTime)
+{
+	// Indexed loop, new pools can be created while updating
+	for (size_t i{}; i < m_UpdatePools.size(); ++i)
+	{
+		m_UpdatePools[i]->Update(deltaTime);
+	}
+}
+
+void ComponentRegistry::LateUpdate()
+{
+	for (size_t i{}; i < m_LateUpdatePools.size(); ++i)
+	{
+		m_LateUpdatePools[i]->LateUpdate();
+	}
+}
@@ -0,0 +1,186 @@
+﻿#pragma once
+
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include "Allocators/ObjectPoolAllocator.h"
+#include "EngineIO/Reflection.h"
+
+class ComponentBase;
+template <typename T> class TypeIdentifier;
+
+/** The virtual hooks of ComponentBase that a component type overrides.*/
+struct ComponentHooks
+{
+	bool update{};
+	bool lateUpdate{};
+	bool beginPlay{};
+};
+
+/**
+ * Type erased part of a ComponentPool so the registry can manage and update pools of every type together.
+ * Keeps the live components of the pool in a dense array that is iterated linearly when updating.
+ */
+class ComponentPoolBase
+{
+public:
+
+	ComponentPoolBase(uint32_t typeId, ComponentHooks hooks) : m_TypeId{ typeId }, m_Hooks{ hooks } {}
+	virtual ~ComponentPoolBase() = default;
+
+	ComponentPoolBase(const ComponentPoolBase&) = delete;
+	ComponentPoolBase(ComponentPoolBase&&) = delete;
+	ComponentPoolBase& operator=(const ComponentPoolBase&) = delete;
+	ComponentPoolBase& operator=(ComponentPoolBase&&) = delete;
+
+	/** Calls the destructor of the component and gives its memory back to the pool.*/
+	virtual void Destroy(ComponentBase* pComponent) = 0;
+
+	/** Updates every component in the pool whose game object has begun playing.*/
+	void Update(float deltaTime);
+
+	/** Late updates every component in the pool whose game object has begun playing.*/
+	void LateUpdate();
+
+	uint32_t GetTypeId() const { return m_TypeId; }
+
+	/** Returns which hooks the component type overrides, the others do not have to be called.*/
+	const ComponentHooks& GetHooks() const { return m_Hooks; }
+
+	/** Returns the amount of live components in the pool.*/
+	size_t GetSize() const { return m_Components.size(); }
+
+	const std::vector<ComponentBase*>& GetComponents() const { return m_Components; }
+
+protected:
+
+	void AddComponent(ComponentBase* pComponent);
+
+	/**
+	 * Removes the component from the dense array.
+	 * While the pool is being updated the slot is only cleared, the array gets compacted once the pass is done
+	 * so swapping the last component into an already visited slot cannot make the pass skip it.
+	 */
+	void RemoveComponent(ComponentBase* pComponent);
+
+	std::vector<ComponentBase*> m_Components;
+
+private:
+
+	/** Removes the slots cleared while updating and fixes the pool indices of the components that moved.*/
+	void CompactComponents();
+
+	uint32_t m_TypeId{};
+
+	bool m_IsUpdating{};
+	bool m_HasRemovedWhileUpdating{};
+
+	ComponentHooks m_Hooks{};
+
+};
+
+/**
+ * Keeps every component of type T of a scene in chunks of contiguous memory.
+ * Components never move once created, so raw pointers and weak references to them stay valid until they are destroyed.
+ */
+template <typename T>
+class ComponentPool final : public ComponentPoolBase
+{
+	static constexpr size_t ChunkSize{ 256 };
+
+public:
+
+	ComponentPool() : ComponentPoolBase(class_id<T>(), TypeIdentifier<T>::Hooks) {}
+
+	~ComponentPool() override
+	{
+		for (ComponentBase* pComponent : m_Components)
+		{
+			T* pTyped = static_cast<T*>(pComponent);
+			pTyped->~T();
+			m_Allocator.deallocate(pTyped);
+		}
+	}
+
+	T* Create()
+	{
+		T* pComponent = new (m_Allocator.allocate()) T();
+		AddComponent(pComponent);
+		return pComponent;
+	}
+
+	void Destroy(ComponentBase* pComponent) override
+	{
+		RemoveComponent(pComponent);
+
+		T* pTyped = static_cast<T*>(pComponent);
+		pTyped->~T();
+		m_Allocator.deallocate(pTyped);
+	}
+
+private:
+
+	ObjectPoolAllocator<T> m_Allocator{ ChunkSize };
+
+};
+
+/**
+ * Owns the component pools of a scene, one pool per component type keyed by its class_id.
+ * The pools are updated in the order their type was first added to the scene.
+ * Only the pools of types that override Update or LateUpdate are put in the tick lists that get updated.
+ */
+class ComponentRegistry final
+{
+public:
+
+	ComponentRegistry() = default;
+	~ComponentRegistry() = default;
+
+	ComponentRegistry(const ComponentRegistry&) = delete;
+	ComponentRegistry(ComponentRegistry&&) = delete;
+	ComponentRegistry& operator=(const ComponentRegistry&) = delete;
+	ComponentRegistry& operator=(ComponentRegistry&&) = delete;
+
+	template <typename T>
+	T* Create()
+	{
+		return GetPool<T>().Create();
+	}
+
+	void Destroy(ComponentBase* pComponent);
+
+	void Update(float deltaTime);
+
+	void LateUpdate();
+
+	template <typename T>
+	ComponentPool<T>& GetPool()
+	{
+		constexpr uint32_t typeId{ class_id<T>() };
+		auto it = m_PoolLookUp.find(typeId);
+		if (it != m_PoolLookUp.end())
+			return *static_cast<ComponentPool<T>*>(it->second);
+
+		auto pPool = new ComponentPool<T>();
+		m_Pools.emplace_back(pPool);
+		m_PoolLookUp.emplace(typeId, pPool);
+
+		if (pPool->GetHooks().update) m_UpdatePools.emplace_back(pPool);
+		if (pPool->GetHooks().lateUpdate) m_LateUpdatePools.emplace_back(pPool);
+
+		return *pPool;
+	}
+
+	const std::vector<std::unique_ptr<ComponentPoolBase>>& GetPools() const { return m_Pools; }
+
+private:
+
+	std::vector<std::unique_ptr<ComponentPoolBase>> m_Pools;
+	std::unordered_map<uint32_t, ComponentPoolBase*> m_PoolLookUp;
+
+	/** Tick lists of the pools whose type needs the Update or LateUpdate call*/
+	std::vector<ComponentPoolBase*> m_UpdatePools;
+	std::vector<ComponentPoolBase*> m_LateUpdatePools;
+
+};
@@ -7,50 +7,32 @@
 #include "imgui.h"
 #include "Singletons/GUIManager.h"
 
-GameObject::GameObject()
-	: m_Reference	{ std::shared_ptr<GameObject>(this,[](GameObject*){}) }
+GameObject::GameObject(Scene* pScene)
+	: m_pScene		{ pScene }
+	, m_pRegistry	{ &pScene->m_ComponentRegistry }
+	, m_Reference	{ std::shared_ptr<GameObject>(this,[](GameObject*){}) }
 {
 	m_pTransform = AddComponent<Transform>();
+	m_pTransform->BindStore(&pScene->m_TransformStore);
 }
 
-GameObject::~GameObject()
+void GameObject::BindRenderBounds()
 {
-	for (auto comp : m_Components)
-	{
-		delete comp.second;
-	}
-
-	for (auto obj : m_Children)
-	{
-		delete obj;
-	}
-
+	m_pRenderComponent->BindBoundsTree(&m_pScene->m_RenderBoundsTree);
 }
 
-void GameObject::Update(float deltaTime)
+GameObject::~GameObject()
 {
 	for (auto comp : m_Components)
 	{
-		comp.second->Update(deltaTime);
+		m_pRegistry->Destroy(comp.second);
 	}
 
 	for (auto obj : m_Children)
 	{
-		obj->Update(deltaTime);
-	}
-}
-
-void GameObject::LateUpdate()
-{
-	for (auto comp : m_Components)
-	{
-		comp.second->LateUpdate();
+		delete obj;
 	}
 
-	for (auto obj : m_Children)
-	{
-		obj->LateUpdate();
-	}
 }
 
 void GameObject::Render() const
@@ -67,7 +49,8 @@ void GameObject::BeginPlay()
 {
 	for (auto comp : m_Components)
 	{
-		comp.second->BeginPlay();
+		if (comp.second->m_pPool->GetHooks().beginPlay)
+			comp.second->BeginPlay();
 	}
 	m_HasBegunPlay = true;
 
@@ -119,7 +102,7 @@ void GameObject::RemoveComponent(ComponentBase* pComponent)
 	{
 		if (it->second == pComponent) {
 			m_Components.erase(it);
-			delete pComponent;
+			m_pRegistry->Destroy(pComponent);
 			break;
 		}
 	}
@@ -161,7 +144,7 @@ void GameObject::SetParent(GameObject* pObject)
 	//}
 
 	// Set transform relative to parent
-	m_pTransform->Move({});
+	m_pTransform->UpdateParent();
 }
 
 void GameObject::SetParent(Scene& scene)
@@ -186,7 +169,7 @@ void GameObject::SetParent(Scene& scene)
 
 	scene.AddToSceneTree(this);
 
-	m_pTransform->Move({});
+	m_pTransform->UpdateParent();
 }
 
 void GameObject::AddChild(GameObject* pObject)
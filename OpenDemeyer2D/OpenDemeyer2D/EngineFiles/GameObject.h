@@ -7,6 +7,7 @@
 #include <cassert>
 
 #include "EngineIO/Deserializer.h"
+#include "EngineFiles/ComponentRegistry.h"
 
 class Scene;
 class Transform;
@@ -49,8 +50,8 @@ class GameObject final
 
 private:
 
-	GameObject();
-	
+	GameObject(Scene* pScene);
+
 
 	/** 
 	* Will destroy the game object immediately.
@@ -65,12 +66,6 @@ private:
 
 public:
 
-	/** Updates the components attached to this component.*/
-	void Update(float deltaTime);
-
-	/** Update the components after the normal update*/
-	void LateUpdate();
-
 	/** Calls the BeginPlay method of the components after all components have begun playing.*/
 	void BeginPlay();
 
@@ -152,6 +147,9 @@ public:
 	*/
 	Scene* GetScene() const { return m_pScene; }
 
+	/** Returns true if BeginPlay was called on this object.*/
+	bool HasBegunPlay() const { return m_HasBegunPlay; }
+
 	/** Get the underlying unordered map that containts the components. */
 	inline const std::unordered_map<uint32_t, ComponentBase*>& GetComponents() { return m_Components; };
 
@@ -185,6 +183,11 @@ public:
 
 	void Copy(GameObject* originalObject, CopyLinker* copyLinker = nullptr);
 
+private:
+
+	/** Adds the bounds of the render component to the render bounds tree of the scene.*/
+	void BindRenderBounds();
+
 private:
 
 	/** Container of all the components attached to this GameObject.*/
@@ -202,6 +205,9 @@ private:
 	/** Reference to the owning scene.*/
 	Scene* m_pScene{};
 
+	/** Registry of the owning scene that stores the components.*/
+	ComponentRegistry* m_pRegistry{};
+
 	/** Shared pointer with empty destructor for which you can ask a weak reference to*/
 	std::shared_ptr<GameObject> m_Reference;
 
@@ -258,7 +264,7 @@ T* GameObject::AddComponent()
 	{
 		throw std::runtime_error("Component already in object");
 	}
-	T* comp = new T();
+	T* comp = m_pRegistry->Create<T>();
 	constexpr uint32_t typeId{ class_id<T>() };
 	m_Components.insert({ typeId, comp});
 
@@ -270,6 +276,7 @@ T* GameObject::AddComponent()
 	if constexpr (std::is_same_v<T, RenderComponent>)
 	{
 		m_pRenderComponent = reinterpret_cast<RenderComponent*>(comp);
+		BindRenderBounds();
 	}
 
 	return comp;
@@ -284,7 +291,7 @@ void GameObject::RemoveComponent()
 	auto it = m_Components.find(typeId);
 	if (it != m_Components.end())
 	{
-		delete it->second;
+		m_pRegistry->Destroy(it->second);
 		m_Components.erase(it);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,90 @@
+﻿#include "pch.h"
+#include "RenderBoundsTree.h"
+
+#include <algorithm>
+
+#include "Components/RenderComponent.h"
+
+int32_t RenderBoundsTree::Create(RenderComponent* pComponent)
+{
+	// Start with empty bounds at the origin, the real bounds follow in the next update
+	b2AABB aabb{};
+	const int32_t proxy{ m_Tree.CreateProxy(aabb, pComponent) };
+	++m_Size;
+
+	return proxy;
+}
+
+void RenderBoundsTree::Destroy(RenderComponent* pComponent, int32_t proxy)
+{
+	if (pComponent->m_IsBoundsDirty)
+	{
+		auto it = std::find(m_DirtyComponents.begin(), m_DirtyComponents.end(), pComponent);
+		*it = m_DirtyComponents.back();
+		m_DirtyComponents.pop_back();
+		pComponent->m_IsBoundsDirty = false;
+	}
+
+	m_Tree.DestroyProxy(proxy);
+	--m_Size;
+}
+
+void RenderBoundsTree::SetDirty(RenderComponent* pComponent)
+{
+	if (pComponent->m_IsBoundsDirty)
+		return;
+
+	pComponent->m_IsBoundsDirty = true;
+	m_DirtyComponents.emplace_back(pComponent);
+}
+
+void RenderBoundsTree::Update()
+{
+	m_MovedAmount = 0;
+
+	for (RenderComponent* pComponent : m_DirtyComponents)
+	{
+		pComponent->m_IsBoundsDirty = false;
+
+		glm::vec2 vertices[4];
+		pComponent->GetWorldRect(vertices);
+
+		b2AABB aabb{ { vertices[0].x, vertices[0].y }, { vertices[0].x, vertices[0].y } };
+		for (int i{ 1 }; i < 4; ++i)
+		{
+			aabb.lowerBound = b2Min(aabb.lowerBound, { vertices[i].x, vertices[i].y });
+			aabb.upperBound = b2Max(aabb.upperBound, { vertices[i].x, vertices[i].y });
+		}
+
+		// Still inside the margin of the stored bounds
+		if (m_Tree.GetFatAABB(pComponent->m_BoundsProxy).Contains(aabb))
+			continue;
+
+		aabb.lowerBound -= { BoundsMargin, BoundsMargin };
+		aabb.upperBound += { BoundsMargin, BoundsMargin };
+		m_Tree.MoveProxy(pComponent->m_BoundsProxy, aabb, { 0.f, 0.f });
+		++m_MovedAmount;
+	}
+
+	m_DirtyComponents.clear();
+}
+
+size_t RenderBoundsTree::Cull(const SDL_FRect& view)
+{
+	++m_Frame;
+	m_VisibleAmount = 0;
+
+	const b2AABB aabb{ { view.x, view.y }, { view.x + view.w, view.y + view.h } };
+	m_Tree.Query(this, aabb);
+
+	return m_VisibleAmount;
+}
+
+bool RenderBoundsTree::QueryCallback(int32 proxy)
+{
+	auto pComponent = static_cast<RenderComponent*>(m_Tree.GetUserData(proxy));
+	pComponent->m_VisibleFrame = m_Frame;
+	++m_VisibleAmount;
+
+	return true;
+}
@@ -0,0 +1,77 @@
+﻿#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <SDL.h>
+#include <b2_dynamic_tree.h>
+
+class RenderComponent;
+
+/**
+ * Dynamic AABB tree holding the world bounds of every render component in a scene, built on the broad-phase tree of Box2D.
+ * Render components flag their bounds when their transform, source rectangle or pivot changes.
+ * The flagged bounds are recalculated in one pass before the scene is culled.
+ * Bounds are stored with a margin so small movements do not reinsert the proxy in the tree.
+ */
+class RenderBoundsTree final
+{
+public:
+
+	static constexpr int32_t InvalidProxy{ -1 };
+
+	/** Extra space in pixels around the bounds stored in the tree.*/
+	static constexpr float BoundsMargin{ 16.f };
+
+	RenderBoundsTree() = default;
+	~RenderBoundsTree() = default;
+
+	RenderBoundsTree(const RenderBoundsTree&) = delete;
+	RenderBoundsTree(RenderBoundsTree&&) = delete;
+	RenderBoundsTree& operator=(const RenderBoundsTree&) = delete;
+	RenderBoundsTree& operator=(RenderBoundsTree&&) = delete;
+
+	/** Creates a proxy for the component and returns it. The bounds are calculated during the next update.*/
+	int32_t Create(RenderComponent* pComponent);
+
+	void Destroy(RenderComponent* pComponent, int32_t proxy);
+
+	/** Flags the bounds of the component to be recalculated during the next update.*/
+	void SetDirty(RenderComponent* pComponent);
+
+	/** Recalculates the bounds of every flagged component.*/
+	void Update();
+
+	/**
+	 * Marks every component that overlaps the view as visible for this frame.
+	 * Returns the amount of visible components.
+	 */
+	size_t Cull(const SDL_FRect& view);
+
+	/** Changes every time the scene is culled, components that were found store the frame they were visible in.*/
+	uint32_t GetFrame() const { return m_Frame; }
+
+	/** Returns the amount of components in the tree.*/
+	size_t GetSize() const { return m_Size; }
+
+	/** Returns the amount of components that overlapped the view during the last cull.*/
+	size_t GetVisibleAmount() const { return m_VisibleAmount; }
+
+	/** Returns the amount of proxies that were reinserted during the last update.*/
+	size_t GetMovedAmount() const { return m_MovedAmount; }
+
+	/** Needed by b2DynamicTree::Query*/
+	bool QueryCallback(int32 proxy);
+
+private:
+
+	b2DynamicTree m_Tree;
+
+	std::vector<RenderComponent*> m_DirtyComponents;
+
+	uint32_t m_Frame{};
+	size_t m_Size{};
+	size_t m_VisibleAmount{};
+	size_t m_MovedAmount{};
+
+};
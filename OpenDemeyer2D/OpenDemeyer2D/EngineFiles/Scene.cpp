@@ -4,9 +4,11 @@
 #include "EngineFiles/GameObject.h"
 #include "imgui.h"
 #include "Components/PhysicsComponent.h"
+#include "Components/Transform.h"
 #include "PhysicsInterface.h"
 
 #include "Singletons/GUIManager.h"
+#include "Singletons/RenderManager.h"
 
 Scene::Scene(const std::string& name)
 	: m_Name{ name }
@@ -34,14 +36,14 @@ Scene::~Scene()
 
 GameObject* Scene::CreateGameObject(GameObject* pParent)
 {
-	GameObject* pObject = new GameObject();
-	pObject->m_pScene = this;
+	GameObject* pObject = new GameObject(this);
 	RegisterObject(pObject);
 
 	if (pParent)
 	{
 		pObject->m_Parent = pParent;
 		pParent->m_Children.emplace_back(pObject);
+		pObject->GetTransform()->UpdateParent();
 	}
 	else
 	{
@@ -53,6 +55,18 @@ GameObject* Scene::CreateGameObject(GameObject* pParent)
 	return pObject;
 }
 
+void Scene::ReserveGameObjects(size_t amount, size_t rootAmount)
+{
+	m_RegisteredObjects.reserve(m_RegisteredObjects.size() + amount);
+	m_UninitializedObject.reserve(m_UninitializedObject.size() + amount);
+	m_NewSceneTreeObjects.reserve(m_NewSceneTreeObjects.size() + rootAmount);
+}
+
+std::shared_ptr<SceneStreamer> Scene::StreamObjects(const std::filesystem::path& file, float frameBudget)
+{
+	return m_Streamers.emplace_back(std::make_shared<SceneStreamer>(this, file, frameBudget));
+}
+
 void Scene::DestroyObject(GameObject* pObject)
 {
 	m_DestroyableObjects.emplace_back(pObject);
@@ -60,6 +74,8 @@ void Scene::DestroyObject(GameObject* pObject)
 
 void Scene::DestroyObjectImmediately(GameObject* pObject)
 {
+	RemovePendingObject(pObject);
+
 	pObject->SetParent(nullptr);
 	delete pObject;
 	m_SceneTree.SwapRemove(pObject);
@@ -70,26 +86,29 @@ void Scene::Update(float deltaTime)
 	if (!m_HasBegunPlay)
 		return;
 
-	// Update every object
-	for (GameObject* child : m_SceneTree)
-	{
-		child->Update(deltaTime);
-	}
+	// Update the components per type instead of walking the scene tree
+	m_ComponentRegistry.Update(deltaTime);
 
-	// Do a late update call for every object
-	for (GameObject* child : m_SceneTree)
-	{
-		child->LateUpdate();
-	}
+	// Do a late update call for every component
+	m_ComponentRegistry.LateUpdate();
 }
 
 void Scene::PreUpdate(bool IsPlaying)
 {
-	// initialized objects
-	for (GameObject* pObject : m_UninitializedObject)
+	// build the streamed objects first so they are initialized and added to the scene tree this frame
+	const size_t firstStreamedObject{ m_UninitializedObject.size() };
+	if (!m_Streamers.empty() && m_Streamers.front()->Update())
+		m_Streamers.erase(m_Streamers.begin());
+
+	// initialized objects, the ones the streamer just created are kept apart
+	for (size_t i{}; i < m_UninitializedObject.size(); ++i)
 	{
+		GameObject* pObject = m_UninitializedObject[i];
 		//m_SceneTree.emplace_back(pObject);
-		m_NotBegunObjects.emplace_back(pObject);
+		if (i < firstStreamedObject)
+			m_NotBegunObjects.emplace_back(pObject);
+		else
+			m_NotBegunStreamedObjects.emplace_back(pObject);
 		pObject->InitializeComponents();
 	}
 	m_UninitializedObject.clear();
@@ -109,6 +128,15 @@ void Scene::PreUpdate(bool IsPlaying)
 			pObject->BeginPlay();
 		}
 		m_NotBegunObjects.clear();
+
+		if (m_Streamers.empty())
+		{
+			for (GameObject* pObject : m_NotBegunStreamedObjects)
+			{
+				pObject->BeginPlay();
+			}
+			m_NotBegunStreamedObjects.clear();
+		}
 	}
 }
 
@@ -121,10 +149,18 @@ void Scene::AfterUpdate()
 		DestroyObjectImmediately(object);
 	}
 	m_DestroyableObjects.clear();
+
+	// Calculate the world values of every transform that changed this frame in one pass
+	m_TransformStore.Update();
 }
 
-void Scene::Render() const
+void Scene::Render()
 {
+	// Only the render components that overlap the view get submitted.
+	// The scene tree is still walked so the sprites keep their submission order.
+	m_RenderBoundsTree.Update();
+	m_RenderBoundsTree.Cull(RENDER.GetViewRect());
+
 	for (GameObject* child : m_SceneTree)
 	{
 		child->Render();
@@ -221,6 +257,23 @@ void Scene::RemoveObject(GameObject* object)
 	m_SceneTree.RSwapRemove(object);
 }
 
+void Scene::RemovePendingObject(GameObject* pObject)
+{
+	// Objects that have begun play are no longer in any of the lists, their children can still be new
+	if (!pObject->HasBegunPlay())
+	{
+		std::erase(m_UninitializedObject, pObject);
+		std::erase(m_NotBegunObjects, pObject);
+		std::erase(m_NotBegunStreamedObjects, pObject);
+		std::erase(m_NewSceneTreeObjects, pObject);
+	}
+
+	for (GameObject* pChild : pObject->GetChildren())
+	{
+		RemovePendingObject(pChild);
+	}
+}
+
 //void Scene::SetScene(GameObject* object)
 //{
 //	object->m_pScene = this;
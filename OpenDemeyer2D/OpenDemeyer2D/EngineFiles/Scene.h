@@ -10,7 +10,11 @@
 #include "UtilityFiles/ODArray.h"
 
 #include "EngineIO/Deserializer.h"
+#include "EngineIO/SceneStreamer.h"
 #include "PhysicsInterface.h"
+#include "ComponentRegistry.h"
+#include "TransformStore.h"
+#include "RenderBoundsTree.h"
 
 class GameObject;
 class b2World;
@@ -41,6 +45,24 @@ public:
 	*/
 	GameObject* CreateGameObject(GameObject* pParent = nullptr);
 
+	/**
+	* Reserves room for the given amount of new Game Objects so creating them does not reallocate the bookkeeping of the scene
+	* @param rootAmount The amount of the new objects that will be at the top of the scene tree
+	*/
+	void ReserveGameObjects(size_t amount, size_t rootAmount);
+
+	/**
+	* Loads the objects of a scene file into this scene over multiple frames, see SceneStreamer.
+	* Multiple files are streamed one after the other. BeginPlay of the streamed objects is held back until streaming is done
+	* so the references between them are linked first. Other new objects still begin play the frame after they are created.
+	*/
+	std::shared_ptr<SceneStreamer> StreamObjects(const std::filesystem::path& file, float frameBudget = SceneStreamer::DefaultFrameBudget);
+
+	/** Returns true while objects are being streamed into the scene*/
+	bool IsStreaming() const { return !m_Streamers.empty(); }
+
+	const std::vector<std::shared_ptr<SceneStreamer>>& GetStreamers() const { return m_Streamers; }
+
 	/** Adds a Scene object to the top of the scene tree.*/
 	//GameObject* Add(GameObject* pObject);
 
@@ -59,8 +81,8 @@ public:
 	/** Updates the scene objects after their Update function was called*/
 	void AfterUpdate();
 
-	/** Renders the scene objects in the scene tree.*/
-	void Render() const;
+	/** Culls the render components against the view of the camera and renders the scene objects in the scene tree.*/
+	void Render();
 
 	/** Returns the name of this scene.*/
 	const std::string& GetName() { return m_Name; }
@@ -102,6 +124,15 @@ public:
 
 	inline const std::filesystem::path& GetFilePath() const { return m_FilePath; }
 
+	/** Returns the store that holds the local and world values of every transform in this scene*/
+	inline const TransformStore& GetTransformStore() const { return m_TransformStore; }
+
+	/** Returns the tree that holds the world bounds of every render component in this scene*/
+	inline const RenderBoundsTree& GetRenderBoundsTree() const { return m_RenderBoundsTree; }
+
+	/** Returns the registry that stores the components of every object in this scene per type*/
+	inline const ComponentRegistry& GetComponentRegistry() const { return m_ComponentRegistry; }
+
 private:
 
 	uint32 m_RegistrationCounter{ };
@@ -115,6 +146,9 @@ private:
 	/** Remove the object from the scene tree list*/
 	void RemoveObject(GameObject* object);
 
+	/** Removes the object and its children from the lists of objects waiting to be initialized or to begin play*/
+	void RemovePendingObject(GameObject* pObject);
+
 private:
 
 	std::string m_Name;
@@ -127,10 +161,24 @@ private:
 	std::vector<GameObject*> m_NotBegunObjects;
 	std::vector<GameObject*> m_NewSceneTreeObjects;
 
+	/** Objects created by the streamers, they only begin play once every streamer is done so their references are linked*/
+	std::vector<GameObject*> m_NotBegunStreamedObjects;
+
 	std::unordered_map<uint32, GameObject*> m_RegisteredObjects;
 
+	std::vector<std::shared_ptr<SceneStreamer>> m_Streamers;
+
 	std::unique_ptr<PhysicsInterface> m_PhysicsInterface;
 
+	/** Declared before the registry so the transforms can still release their handles when destroyed.*/
+	TransformStore m_TransformStore;
+
+	/** Declared before the registry so the render components can still remove their bounds when destroyed.*/
+	RenderBoundsTree m_RenderBoundsTree;
+
+	/** Declared after the physics interface so left over components are destroyed before it.*/
+	ComponentRegistry m_ComponentRegistry;
+
 	std::filesystem::path m_FilePath;
 
 	bool m_HasBegunPlay{};
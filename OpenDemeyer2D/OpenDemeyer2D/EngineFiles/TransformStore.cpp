@@ -0,0 +1,338 @@
+﻿#include "pch.h"
+#include "TransformStore.h"
+
+#include <xmmintrin.h>
+
+/** Moves the values so that the value at order[i] ends up at index i*/
+template <typename T>
+static void Reorder(std::vector<T>& values, const FrameVector<uint32_t>& order)
+{
+	std::vector<T> sorted(order.size());
+	for (size_t i{}; i < order.size(); ++i)
+	{
+		sorted[i] = values[order[i]];
+	}
+	values = std::move(sorted);
+}
+
+uint32_t TransformStore::Create()
+{
+	uint32_t handle{};
+	if (!m_FreeHandles.empty())
+	{
+		handle = m_FreeHandles.back();
+		m_FreeHandles.pop_back();
+	}
+	else
+	{
+		handle = uint32_t(m_HandleToIndex.size());
+		m_HandleToIndex.emplace_back();
+	}
+
+	m_HandleToIndex[handle] = uint32_t(m_Handles.size());
+	m_Handles.emplace_back(handle);
+	m_Parents.emplace_back(InvalidHandle);
+
+	m_LocalPosition.emplace_back(0.f, 0.f);
+	m_LocalScale.emplace_back(1.f, 1.f);
+	m_LocalRotation.emplace_back(0.f);
+	m_LocalSin.emplace_back(0.f);
+	m_LocalCos.emplace_back(1.f);
+	m_LocalA.emplace_back(1.f);
+	m_LocalB.emplace_back(0.f);
+	m_LocalC.emplace_back(0.f);
+	m_LocalD.emplace_back(1.f);
+
+	m_WorldA.emplace_back(1.f);
+	m_WorldB.emplace_back(0.f);
+	m_WorldC.emplace_back(0.f);
+	m_WorldD.emplace_back(1.f);
+	m_WorldX.emplace_back(0.f);
+	m_WorldY.emplace_back(0.f);
+
+	m_WorldPosition.emplace_back(0.f, 0.f);
+	m_WorldScale.emplace_back(1.f, 1.f);
+	m_WorldRotation.emplace_back(0.f);
+
+	m_IsDirty.emplace_back(uint8_t{ 1 });
+	m_HasDirty = true;
+
+	// The new transform is a root at the end of the arrays
+	m_IsSorted = false;
+
+	return handle;
+}
+
+void TransformStore::Destroy(uint32_t handle)
+{
+	// The slot gets removed the next time the arrays are sorted
+	m_Handles[m_HandleToIndex[handle]] = InvalidHandle;
+	m_FreeHandles.emplace_back(handle);
+	m_IsSorted = false;
+}
+
+void TransformStore::SetParent(uint32_t handle, uint32_t parentHandle)
+{
+	m_Parents[m_HandleToIndex[handle]] = (parentHandle != InvalidHandle) ? m_HandleToIndex[parentHandle] : InvalidHandle;
+	m_IsSorted = false;
+}
+
+void TransformStore::SetLocal(uint32_t handle, const glm::vec2& position, const glm::vec2& scale, float rotation)
+{
+	const uint32_t index{ m_HandleToIndex[handle] };
+
+	m_LocalPosition[index] = position;
+	m_LocalScale[index] = scale;
+
+	// Most changes are only moves, so the sine and cosine are cached
+	if (m_LocalRotation[index] != rotation)
+	{
+		m_LocalRotation[index] = rotation;
+		m_LocalSin[index] = sinf(glm::radians(rotation));
+		m_LocalCos[index] = cosf(glm::radians(rotation));
+	}
+
+	const Affine2D local{ Affine2D::FromTransform(position, scale, m_LocalSin[index], m_LocalCos[index]) };
+	m_LocalA[index] = local.a;
+	m_LocalB[index] = local.b;
+	m_LocalC[index] = local.c;
+	m_LocalD[index] = local.d;
+}
+
+bool TransformStore::SetDirty(uint32_t handle)
+{
+	const uint32_t index{ m_HandleToIndex[handle] };
+	if (m_IsDirty[index])
+		return false;
+
+	m_IsDirty[index] = 1;
+	m_HasDirty = true;
+	return true;
+}
+
+void TransformStore::ResolveWorld(uint32_t index) const
+{
+	const uint32_t parentIndex{ m_Parents[index] };
+	if (parentIndex == InvalidHandle)
+	{
+		ComposeRoot(index);
+	}
+	else
+	{
+		if (m_IsDirty[parentIndex])
+			ResolveWorld(parentIndex);
+
+		ComposeWorld(index, parentIndex);
+	}
+
+	m_IsDirty[index] = 0;
+}
+
+void TransformStore::ComposeWorld(uint32_t index, uint32_t parentIndex) const
+{
+	const Affine2D parent{
+		m_WorldA[parentIndex], m_WorldB[parentIndex],
+		m_WorldC[parentIndex], m_WorldD[parentIndex],
+		m_WorldX[parentIndex], m_WorldY[parentIndex] };
+	const Affine2D local{
+		m_LocalA[index], m_LocalB[index],
+		m_LocalC[index], m_LocalD[index],
+		m_LocalPosition[index].x, m_LocalPosition[index].y };
+
+	const Affine2D world{ parent * local };
+
+	m_WorldA[index] = world.a;
+	m_WorldB[index] = world.b;
+	m_WorldC[index] = world.c;
+	m_WorldD[index] = world.d;
+	m_WorldX[index] = world.x;
+	m_WorldY[index] = world.y;
+
+	m_WorldPosition[index] = world.GetPosition();
+	m_WorldScale[index] = m_WorldScale[parentIndex] * m_LocalScale[index];
+	m_WorldRotation[index] = m_WorldRotation[parentIndex] + m_LocalRotation[index];
+}
+
+void TransformStore::ComposeRoot(uint32_t index) const
+{
+	const glm::vec2& localPosition{ m_LocalPosition[index] };
+
+	m_WorldA[index] = m_LocalA[index];
+	m_WorldB[index] = m_LocalB[index];
+	m_WorldC[index] = m_LocalC[index];
+	m_WorldD[index] = m_LocalD[index];
+	m_WorldX[index] = localPosition.x;
+	m_WorldY[index] = localPosition.y;
+
+	m_WorldPosition[index] = localPosition;
+	m_WorldScale[index] = m_LocalScale[index];
+	m_WorldRotation[index] = m_LocalRotation[index];
+}
+
+void TransformStore::Update()
+{
+	if (!m_IsSorted)
+		SortByDepth();
+
+	if (!m_HasDirty)
+		return;
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	if (m_DepthOffsets.size() > 1)
+	{
+		for (uint32_t i{ m_DepthOffsets[0] }; i < m_DepthOffsets[1]; ++i)
+		{
+			ComposeRoot(i);
+		}
+	}
+
+	// Transforms of the same depth do not depend on each other, so they can be calculated four at a time
+	for (size_t depth{ 1 }; depth + 1 < m_DepthOffsets.size(); ++depth)
+	{
+		const uint32_t end{ m_DepthOffsets[depth + 1] };
+		uint32_t i{ m_DepthOffsets[depth] };
+
+		for (; i + 4 <= end; i += 4)
+		{
+			const uint32_t* pParents{ &m_Parents[i] };
+
+			const __m128 pa{ _mm_setr_ps(m_WorldA[pParents[0]], m_WorldA[pParents[1]], m_WorldA[pParents[2]], m_WorldA[pParents[3]]) };
+			const __m128 pb{ _mm_setr_ps(m_WorldB[pParents[0]], m_WorldB[pParents[1]], m_WorldB[pParents[2]], m_WorldB[pParents[3]]) };
+			const __m128 pc{ _mm_setr_ps(m_WorldC[pParents[0]], m_WorldC[pParents[1]], m_WorldC[pParents[2]], m_WorldC[pParents[3]]) };
+			const __m128 pd{ _mm_setr_ps(m_WorldD[pParents[0]], m_WorldD[pParents[1]], m_WorldD[pParents[2]], m_WorldD[pParents[3]]) };
+			const __m128 px{ _mm_setr_ps(m_WorldX[pParents[0]], m_WorldX[pParents[1]], m_WorldX[pParents[2]], m_WorldX[pParents[3]]) };
+			const __m128 py{ _mm_setr_ps(m_WorldY[pParents[0]], m_WorldY[pParents[1]], m_WorldY[pParents[2]], m_WorldY[pParents[3]]) };
+
+			const __m128 la{ _mm_loadu_ps(&m_LocalA[i]) };
+			const __m128 lb{ _mm_loadu_ps(&m_LocalB[i]) };
+			const __m128 lc{ _mm_loadu_ps(&m_LocalC[i]) };
+			const __m128 ld{ _mm_loadu_ps(&m_LocalD[i]) };
+
+			// Deinterleave the local positions into x and y
+			const __m128 localPositions01{ _mm_loadu_ps(&m_LocalPosition[i].x) };
+			const __m128 localPositions23{ _mm_loadu_ps(&m_LocalPosition[i + 2].x) };
+			const __m128 lx{ _mm_shuffle_ps(localPositions01, localPositions23, _MM_SHUFFLE(2, 0, 2, 0)) };
+			const __m128 ly{ _mm_shuffle_ps(localPositions01, localPositions23, _MM_SHUFFLE(3, 1, 3, 1)) };
+
+			const __m128 a{ _mm_add_ps(_mm_mul_ps(pa, la), _mm_mul_ps(pb, lc)) };
+			const __m128 b{ _mm_add_ps(_mm_mul_ps(pa, lb), _mm_mul_ps(pb, ld)) };
+			const __m128 c{ _mm_add_ps(_mm_mul_ps(pc, la), _mm_mul_ps(pd, lc)) };
+			const __m128 d{ _mm_add_ps(_mm_mul_ps(pc, lb), _mm_mul_ps(pd, ld)) };
+			const __m128 x{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(pa, lx), _mm_mul_ps(pb, ly)), px) };
+			const __m128 y{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(pc, lx), _mm_mul_ps(pd, ly)), py) };
+
+			_mm_storeu_ps(&m_WorldA[i], a);
+			_mm_storeu_ps(&m_WorldB[i], b);
+			_mm_storeu_ps(&m_WorldC[i], c);
+			_mm_storeu_ps(&m_WorldD[i], d);
+			_mm_storeu_ps(&m_WorldX[i], x);
+			_mm_storeu_ps(&m_WorldY[i], y);
+
+			_mm_storeu_ps(&m_WorldPosition[i].x, _mm_unpacklo_ps(x, y));
+			_mm_storeu_ps(&m_WorldPosition[i + 2].x, _mm_unpackhi_ps(x, y));
+
+			// Scale and rotation are composed directly, no square roots or atan2 needed
+			const __m128 parentScales01{ _mm_setr_ps(m_WorldScale[pParents[0]].x, m_WorldScale[pParents[0]].y, m_WorldScale[pParents[1]].x, m_WorldScale[pParents[1]].y) };
+			const __m128 parentScales23{ _mm_setr_ps(m_WorldScale[pParents[2]].x, m_WorldScale[pParents[2]].y, m_WorldScale[pParents[3]].x, m_WorldScale[pParents[3]].y) };
+			_mm_storeu_ps(&m_WorldScale[i].x, _mm_mul_ps(parentScales01, _mm_loadu_ps(&m_LocalScale[i].x)));
+			_mm_storeu_ps(&m_WorldScale[i + 2].x, _mm_mul_ps(parentScales23, _mm_loadu_ps(&m_LocalScale[i + 2].x)));
+
+			const __m128 parentRotations{ _mm_setr_ps(m_WorldRotation[pParents[0]], m_WorldRotation[pParents[1]], m_WorldRotation[pParents[2]], m_WorldRotation[pParents[3]]) };
+			_mm_storeu_ps(&m_WorldRotation[i], _mm_add_ps(parentRotations, _mm_loadu_ps(&m_LocalRotation[i])));
+		}
+
+		for (; i < end; ++i)
+		{
+			ComposeWorld(i, m_Parents[i]);
+		}
+	}
+
+	std::fill(m_IsDirty.begin(), m_IsDirty.end(), uint8_t{});
+	m_HasDirty = false;
+
+	m_LastUpdateDuration = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void TransformStore::SortByDepth()
+{
+	const size_t count{ m_Handles.size() };
+
+	// The depth of every live transform, hierarchies are shallow so walking up the parents is cheap
+	FrameVector<uint32_t> depths(count, InvalidHandle);
+	size_t liveCount{};
+	uint32_t maxDepth{};
+	for (size_t i{}; i < count; ++i)
+	{
+		if (m_Handles[i] == InvalidHandle)
+			continue;
+
+		uint32_t depth{};
+		for (uint32_t parent{ m_Parents[i] }; parent != InvalidHandle && m_Handles[parent] != InvalidHandle; parent = m_Parents[parent])
+		{
+			++depth;
+		}
+
+		depths[i] = depth;
+		maxDepth = std::max(maxDepth, depth);
+		++liveCount;
+	}
+
+	// Counting sort on the depth
+	m_DepthOffsets.assign(size_t(maxDepth) + 2, 0);
+	for (uint32_t depth : depths)
+	{
+		if (depth != InvalidHandle)
+			++m_DepthOffsets[depth + 1];
+	}
+	for (size_t i{ 1 }; i < m_DepthOffsets.size(); ++i)
+	{
+		m_DepthOffsets[i] += m_DepthOffsets[i - 1];
+	}
+
+	FrameVector<uint32_t> order(liveCount);
+	FrameVector<uint32_t> newIndices(count, InvalidHandle);
+	FrameVector<uint32_t> cursors(m_DepthOffsets.begin(), m_DepthOffsets.end());
+	for (size_t i{}; i < count; ++i)
+	{
+		if (depths[i] == InvalidHandle)
+			continue;
+
+		const uint32_t newIndex{ cursors[depths[i]]++ };
+		newIndices[i] = newIndex;
+		order[newIndex] = uint32_t(i);
+	}
+
+	Reorder(m_Handles, order);
+	Reorder(m_Parents, order);
+	Reorder(m_LocalPosition, order);
+	Reorder(m_LocalScale, order);
+	Reorder(m_LocalRotation, order);
+	Reorder(m_LocalSin, order);
+	Reorder(m_LocalCos, order);
+	Reorder(m_LocalA, order);
+	Reorder(m_LocalB, order);
+	Reorder(m_LocalC, order);
+	Reorder(m_LocalD, order);
+	Reorder(m_WorldA, order);
+	Reorder(m_WorldB, order);
+	Reorder(m_WorldC, order);
+	Reorder(m_WorldD, order);
+	Reorder(m_WorldX, order);
+	Reorder(m_WorldY, order);
+	Reorder(m_WorldPosition, order);
+	Reorder(m_WorldScale, order);
+	Reorder(m_WorldRotation, order);
+	Reorder(m_IsDirty, order);
+
+	for (uint32_t i{}; i < uint32_t(liveCount); ++i)
+	{
+		m_HandleToIndex[m_Handles[i]] = i;
+
+		// Transforms whose parent was destroyed become roots
+		uint32_t& parent{ m_Parents[i] };
+		parent = (parent != InvalidHandle) ? newIndices[parent] : InvalidHandle;
+	}
+
+	m_IsSorted = true;
+}
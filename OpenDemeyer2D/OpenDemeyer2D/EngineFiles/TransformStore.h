@@ -0,0 +1,131 @@
+﻿#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "glm/glm.hpp"
+#include "UtilityFiles/Affine2D.h"
+
+/**
+ * Stores the local and world values of every transform in a scene as a structure of arrays.
+ * The Transform component is a handle into this store.
+ * The arrays are sorted by hierarchy depth so the world matrices can be calculated parent before child,
+ * four transforms at a time, in a single pass at the end of every frame.
+ * World values that are read before that pass are resolved lazily.
+ * The world scale and rotation are composed directly from the parent instead of being decomposed from the world matrix.
+ *
+ * The matrices are stored per element of an Affine2D.
+ */
+class TransformStore final
+{
+public:
+
+	static constexpr uint32_t InvalidHandle{ UINT32_MAX };
+
+	TransformStore() = default;
+	~TransformStore() = default;
+
+	TransformStore(const TransformStore&) = delete;
+	TransformStore(TransformStore&&) = delete;
+	TransformStore& operator=(const TransformStore&) = delete;
+	TransformStore& operator=(TransformStore&&) = delete;
+
+	/** Creates a transform without a parent and returns the handle to it.*/
+	uint32_t Create();
+
+	void Destroy(uint32_t handle);
+
+	/** Sets the parent of the transform, use InvalidHandle to not have a parent.*/
+	void SetParent(uint32_t handle, uint32_t parentHandle);
+
+	/** Sets the local values of the transform, flag it with SetDirty afterwards.*/
+	void SetLocal(uint32_t handle, const glm::vec2& position, const glm::vec2& scale, float rotation);
+
+	/**
+	 * Flags the world values of the transform as dirty.
+	 * Returns false if it already was dirty.
+	 * The children have to be flagged by the caller.
+	 */
+	bool SetDirty(uint32_t handle);
+
+	/**
+	 * The returned references stay valid until a transform is created
+	 * or until the next time the store is updated.
+	 */
+	const glm::vec2& GetWorldPosition(uint32_t handle) const { return m_WorldPosition[GetResolvedIndex(handle)]; }
+	const glm::vec2& GetWorldScale(uint32_t handle) const { return m_WorldScale[GetResolvedIndex(handle)]; }
+	float GetWorldRotation(uint32_t handle) const { return m_WorldRotation[GetResolvedIndex(handle)]; }
+
+	/** Sorts the transforms by depth if the hierarchy changed and calculates every world matrix.*/
+	void Update();
+
+	/** Returns the amount of live transforms in the store.*/
+	size_t GetSize() const { return m_HandleToIndex.size() - m_FreeHandles.size(); }
+
+	/** Returns the amount of depth levels in the hierarchy.*/
+	size_t GetDepth() const { return m_DepthOffsets.empty() ? 0 : m_DepthOffsets.size() - 1; }
+
+	/** Returns how long the last Update took in milliseconds.*/
+	float GetLastUpdateDuration() const { return m_LastUpdateDuration; }
+
+private:
+
+	uint32_t GetResolvedIndex(uint32_t handle) const
+	{
+		uint32_t index{ m_HandleToIndex[handle] };
+		if (m_IsDirty[index])
+			ResolveWorld(index);
+		return index;
+	}
+
+	/** Calculates the world values of a single transform after resolving its parent.*/
+	void ResolveWorld(uint32_t index) const;
+
+	/** Calculates the world values of a transform from the world matrix of its parent.*/
+	void ComposeWorld(uint32_t index, uint32_t parentIndex) const;
+
+	/** Copies the local values into the world values of a transform without a parent.*/
+	void ComposeRoot(uint32_t index) const;
+
+	/** Sorts the arrays by hierarchy depth, removing the destroyed transforms.*/
+	void SortByDepth();
+
+private:
+
+	/** Handle of the transform stored at every index, InvalidHandle if destroyed*/
+	std::vector<uint32_t> m_Handles;
+
+	/** Index of every handle into the arrays*/
+	std::vector<uint32_t> m_HandleToIndex;
+	std::vector<uint32_t> m_FreeHandles;
+
+	/** Index of the parent or InvalidHandle*/
+	std::vector<uint32_t> m_Parents;
+
+	/** Local values and their affine matrix, the sine and cosine are only recalculated when the rotation changes*/
+	std::vector<glm::vec2> m_LocalPosition;
+	std::vector<glm::vec2> m_LocalScale;
+	std::vector<float> m_LocalRotation;
+	std::vector<float> m_LocalSin, m_LocalCos;
+	std::vector<float> m_LocalA, m_LocalB, m_LocalC, m_LocalD;
+
+	/** World affine matrices, lazily resolved*/
+	mutable std::vector<float> m_WorldA, m_WorldB, m_WorldC, m_WorldD, m_WorldX, m_WorldY;
+
+	/** World values composed from the world values of the parent*/
+	mutable std::vector<glm::vec2> m_WorldPosition;
+	mutable std::vector<glm::vec2> m_WorldScale;
+	mutable std::vector<float> m_WorldRotation;
+
+	mutable std::vector<uint8_t> m_IsDirty;
+
+	/** Index of the first transform of every depth, the last element is the end*/
+	std::vector<uint32_t> m_DepthOffsets;
+
+	bool m_IsSorted{ true };
+
+	bool m_HasDirty{};
+
+	float m_LastUpdateDuration{};
+
+};
@@ -0,0 +1,437 @@
+﻿#include "pch.h"
+#include "BinarySerializer.h"
+
+#include <cstring>
+#include <istream>
+
+#include "Deserializer.h"
+#include "EngineFiles/Scene.h"
+#include "EngineFiles/GameObject.h"
+#include "UtilityFiles/MappedFile.h"
+
+namespace
+{
+	constexpr char Magic[4]{ 'O', 'D', 'B', 'S' };
+
+	/** Size of a text field inside of a record: the offset and the length of the text*/
+	constexpr uint32_t TextFieldSize{ 2 * sizeof(uint32_t) };
+
+	/** Stream buffer that reads straight from the mapped file without copying the text*/
+	class MemoryBuffer final : public std::streambuf
+	{
+	public:
+
+		void SetRange(const char* pBegin, size_t size)
+		{
+			char* pData{ const_cast<char*>(pBegin) };
+			setg(pData, pData, pData + size);
+		}
+	};
+
+	template <typename T>
+	void WriteSection(std::ostream& os, const std::vector<T>& section)
+	{
+		os.write(reinterpret_cast<const char*>(section.data()), std::streamsize(section.size() * sizeof(T)));
+	}
+
+	template <typename T>
+	const T* GetSection(const uint8_t* pFile, size_t fileSize, uint32_t offset, uint32_t amount)
+	{
+		if (offset % alignof(T) != 0 || offset > fileSize || (fileSize - offset) / sizeof(T) < amount)
+			throw ParsingError("Binary file section out of bounds");
+		return reinterpret_cast<const T*>(pFile + offset);
+	}
+}
+
+struct BinarySerializer::LoadState
+{
+	Scene* pScene{};
+	GameObject* pRoot{};
+
+	// the text fields are parsed by their own serializers, straight from the mapped file
+	MemoryBuffer textBuffer{};
+	std::istream textStream{ &textBuffer };
+	Deserializer deserializer{};
+
+	std::vector<GameObject*> createdObjects{};
+};
+
+BinarySerializer::BinarySerializer() = default;
+BinarySerializer::~BinarySerializer() = default;
+
+void BinarySerializer::SerializeScene(std::ostream& os, Scene* pScene)
+{
+	BeginWriting();
+
+	for (GameObject* pObject : pScene->GetSceneTree())
+		AddObject(pObject, NoParent);
+
+	Write(os, pScene->GetName());
+}
+
+void BinarySerializer::SerializeObject(std::ostream& os, GameObject* pObject)
+{
+	BeginWriting();
+
+	AddObject(pObject, NoParent);
+
+	Write(os, pObject->GetName());
+}
+
+Scene* BinarySerializer::DeserializeScene(const MappedFile& file)
+{
+	Prepare(file);
+
+	Scene* pScene{ new Scene(std::string(GetSceneName())) };
+	try
+	{
+		BeginLoading(pScene);
+		while (LoadSubtree());
+		EndLoading();
+	}
+	catch (...)
+	{
+		delete pScene;
+		throw;
+	}
+
+	return pScene;
+}
+
+GameObject* BinarySerializer::DeserializeObject(const MappedFile& file, GameObject* pObject)
+{
+	assert(pObject);
+
+	Prepare(file);
+
+	BeginLoading(pObject->GetScene(), pObject);
+	while (LoadSubtree());
+	EndLoading();
+
+	return pObject;
+}
+
+void BinarySerializer::Prepare(const MappedFile& file)
+{
+	m_pLoadState.reset();
+	m_LoadedObjects = 0;
+
+	ReadHeader(file);
+	BuildPlans();
+}
+
+void BinarySerializer::BeginWriting()
+{
+	m_Types.clear();
+	m_Fields.clear();
+	m_FieldInfos.clear();
+	m_Objects.clear();
+	m_Components.clear();
+	m_Data.clear();
+	m_Strings.clear();
+	m_TypeIndices.clear();
+}
+
+uint32_t BinarySerializer::GetTypeIndex(const ComponentBase* pComponent)
+{
+	const uint32_t classId{ pComponent->GetComponentId() };
+
+	auto it = m_TypeIndices.find(classId);
+	if (it != m_TypeIndices.end())
+		return it->second;
+
+	auto typeInfo = TypeInformation::GetInstance().GetTypeInfo(classId);
+	assert(typeInfo);
+
+	auto& fields = typeInfo->field.GetFields();
+
+	BinaryType type{ classId, uint32_t(m_Fields.size()), uint32_t(fields.size()), 0 };
+	for (auto& [name, info] : fields)
+	{
+		const uint32_t size{ info.isBinaryCopyable ? uint32_t(info.size) : TextFieldSize };
+		m_Fields.emplace_back(BinaryField{ hash(name), type.recordSize, size, !info.isBinaryCopyable });
+		m_FieldInfos.emplace_back(&info);
+		type.recordSize += size;
+	}
+
+	const uint32_t index{ uint32_t(m_Types.size()) };
+	m_Types.emplace_back(type);
+	m_TypeIndices.emplace(classId, index);
+	return index;
+}
+
+uint32_t BinarySerializer::AddString(std::string_view string)
+{
+	const uint32_t offset{ uint32_t(m_Strings.size()) };
+	m_Strings.append(string);
+	return offset;
+}
+
+void BinarySerializer::AddObject(GameObject* pObject, uint32_t parent)
+{
+	const uint32_t index{ uint32_t(m_Objects.size()) };
+	const std::string& name{ pObject->GetName() };
+	m_Objects.emplace_back(BinaryObject{ pObject->GetId(), parent, AddString(name), uint32_t(name.size()), uint32_t(m_Components.size()), 0 });
+
+	for (auto& [id, pComponent] : pObject->GetComponents())
+	{
+		const uint32_t typeIndex{ GetTypeIndex(pComponent) };
+		const BinaryType& type{ m_Types[typeIndex] };
+
+		const uint32_t dataOffset{ uint32_t(m_Data.size()) };
+		m_Components.emplace_back(BinaryComponent{ typeIndex, dataOffset });
+		m_Data.resize(m_Data.size() + type.recordSize);
+
+		for (uint32_t i{ type.firstField }; i < type.firstField + type.fieldAmount; ++i)
+		{
+			const BinaryField& field{ m_Fields[i] };
+			const FieldInfo* pInfo{ m_FieldInfos[i] };
+			uint8_t* pRecord{ m_Data.data() + dataOffset + field.recordOffset };
+
+			if (!field.isText)
+			{
+				std::memcpy(pRecord, reinterpret_cast<const uint8_t*>(pComponent) + pInfo->offset, field.size);
+				continue;
+			}
+
+			m_TextStream.str({});
+			pInfo->Serialize(m_TextStream, pComponent);
+			const std::string text{ m_TextStream.str() };
+
+			const uint32_t textRange[2]{ AddString(text), uint32_t(text.size()) };
+			std::memcpy(pRecord, textRange, sizeof(textRange));
+		}
+	}
+
+	m_Objects[index].componentAmount = uint32_t(m_Components.size()) - m_Objects[index].firstComponent;
+
+	for (GameObject* pChild : pObject->GetChildren())
+		AddObject(pChild, index);
+}
+
+void BinarySerializer::Write(std::ostream& os, std::string_view name)
+{
+	Header header{};
+	std::memcpy(header.magic, Magic, sizeof(Magic));
+	header.version = Version;
+	header.nameLength = uint32_t(name.size());
+	header.nameOffset = AddString(name);
+
+	uint32_t offset{ sizeof(Header) };
+	auto placeSection = [&offset](uint32_t& sectionOffset, size_t size)
+	{
+		sectionOffset = offset;
+		offset += uint32_t(size);
+	};
+
+	header.typeAmount = uint32_t(m_Types.size());
+	placeSection(header.typesOffset, m_Types.size() * sizeof(BinaryType));
+	header.fieldAmount = uint32_t(m_Fields.size());
+	placeSection(header.fieldsOffset, m_Fields.size() * sizeof(BinaryField));
+	header.objectAmount = uint32_t(m_Objects.size());
+	placeSection(header.objectsOffset, m_Objects.size() * sizeof(BinaryObject));
+	header.componentAmount = uint32_t(m_Components.size());
+	placeSection(header.componentsOffset, m_Components.size() * sizeof(BinaryComponent));
+	header.dataSize = uint32_t(m_Data.size());
+	placeSection(header.dataOffset, m_Data.size());
+	header.stringsSize = uint32_t(m_Strings.size());
+	placeSection(header.stringsOffset, m_Strings.size());
+
+	os.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	WriteSection(os, m_Types);
+	WriteSection(os, m_Fields);
+	WriteSection(os, m_Objects);
+	WriteSection(os, m_Components);
+	WriteSection(os, m_Data);
+	os.write(m_Strings.data(), std::streamsize(m_Strings.size()));
+}
+
+void BinarySerializer::ReadHeader(const MappedFile& file)
+{
+	if (!file.IsValid() || file.GetSize() < sizeof(Header))
+		throw ParsingError("Binary file is too small");
+
+	m_pFile = file.GetData();
+	m_pHeader = reinterpret_cast<const Header*>(m_pFile);
+
+	if (std::memcmp(m_pHeader->magic, Magic, sizeof(Magic)) != 0)
+		throw ParsingError("Not a binary scene file");
+	if (m_pHeader->version != Version)
+		throw ParsingError("Binary file version " + std::to_string(m_pHeader->version) + " is not supported");
+
+	// only checks the bounds, the sections get read in place
+	const size_t size{ file.GetSize() };
+	GetSection<BinaryType>(m_pFile, size, m_pHeader->typesOffset, m_pHeader->typeAmount);
+	GetSection<BinaryField>(m_pFile, size, m_pHeader->fieldsOffset, m_pHeader->fieldAmount);
+	GetSection<BinaryObject>(m_pFile, size, m_pHeader->objectsOffset, m_pHeader->objectAmount);
+	GetSection<BinaryComponent>(m_pFile, size, m_pHeader->componentsOffset, m_pHeader->componentAmount);
+	GetSection<uint8_t>(m_pFile, size, m_pHeader->dataOffset, m_pHeader->dataSize);
+	GetSection<char>(m_pFile, size, m_pHeader->stringsOffset, m_pHeader->stringsSize);
+}
+
+void BinarySerializer::BuildPlans()
+{
+	auto pTypes{ reinterpret_cast<const BinaryType*>(m_pFile + m_pHeader->typesOffset) };
+	auto pFields{ reinterpret_cast<const BinaryField*>(m_pFile + m_pHeader->fieldsOffset) };
+
+	m_TypePlans.clear();
+	m_FieldPlans.clear();
+
+	auto& types = TypeInformation::GetInstance();
+	std::unordered_map<uint32_t, const FieldInfo*> liveFields;
+
+	for (uint32_t typeIndex{}; typeIndex < m_pHeader->typeAmount; ++typeIndex)
+	{
+		const BinaryType& type{ pTypes[typeIndex] };
+
+		auto typeInfo = types.GetTypeInfo(type.classId);
+		if (!typeInfo)
+			throw ParsingError("Unknown component type in binary file");
+		if (type.firstField > m_pHeader->fieldAmount || m_pHeader->fieldAmount - type.firstField < type.fieldAmount)
+			throw ParsingError("Binary file field table out of bounds");
+
+		liveFields.clear();
+		for (auto& [name, info] : typeInfo->field.GetFields())
+			liveFields.emplace(hash(name), &info);
+
+		TypePlan plan{ typeInfo, uint32_t(m_FieldPlans.size()), 0, type.recordSize };
+
+		for (uint32_t i{ type.firstField }; i < type.firstField + type.fieldAmount; ++i)
+		{
+			const BinaryField& field{ pFields[i] };
+			if (field.recordOffset > type.recordSize || type.recordSize - field.recordOffset < field.size)
+				throw ParsingError("Binary file field out of bounds");
+
+			// fields that no longer exist or changed their layout are skipped
+			auto it = liveFields.find(field.nameHash);
+			if (it == liveFields.end())
+				continue;
+
+			const FieldInfo* pInfo{ it->second };
+			if (field.isText ? field.size != TextFieldSize : (!pInfo->isBinaryCopyable || pInfo->size != field.size))
+				continue;
+
+			m_FieldPlans.emplace_back(FieldPlan{ pInfo, field.recordOffset, field.size, bool(field.isText) });
+			++plan.fieldAmount;
+		}
+
+		m_TypePlans.emplace_back(plan);
+	}
+}
+
+std::string_view BinarySerializer::GetString(uint32_t offset, uint32_t length) const
+{
+	if (offset > m_pHeader->stringsSize || m_pHeader->stringsSize - offset < length)
+		throw ParsingError("Binary file string out of bounds");
+
+	return { reinterpret_cast<const char*>(m_pFile + m_pHeader->stringsOffset + offset), length };
+}
+
+void BinarySerializer::BeginLoading(Scene* pScene, GameObject* pRoot)
+{
+	assert(m_pHeader);
+
+	if (pRoot && m_pHeader->objectAmount == 0)
+		throw ParsingError("Binary object file is empty");
+
+	m_pLoadState = std::make_unique<LoadState>();
+	m_pLoadState->pScene = pScene;
+	m_pLoadState->pRoot = pRoot;
+	m_pLoadState->deserializer.m_pIStream = &m_pLoadState->textStream;
+	m_pLoadState->createdObjects.resize(m_pHeader->objectAmount);
+
+	m_LoadedObjects = 0;
+}
+
+bool BinarySerializer::LoadSubtree()
+{
+	assert(m_pLoadState);
+
+	if (m_LoadedObjects >= m_pHeader->objectAmount)
+		return false;
+
+	// the children directly follow their parent, the subtree ends at the next top level object
+	auto pObjects{ reinterpret_cast<const BinaryObject*>(m_pFile + m_pHeader->objectsOffset) };
+	do
+	{
+		LoadObject(m_LoadedObjects++);
+	} while (m_LoadedObjects < m_pHeader->objectAmount && pObjects[m_LoadedObjects].parent != NoParent);
+
+	return true;
+}
+
+void BinarySerializer::EndLoading()
+{
+	assert(m_pLoadState);
+
+	m_pLoadState->deserializer.LinkComponents();
+	m_pLoadState.reset();
+}
+
+void BinarySerializer::LoadObject(uint32_t objectIndex)
+{
+	auto pObjects{ reinterpret_cast<const BinaryObject*>(m_pFile + m_pHeader->objectsOffset) };
+	auto pComponents{ reinterpret_cast<const BinaryComponent*>(m_pFile + m_pHeader->componentsOffset) };
+	const uint8_t* pData{ m_pFile + m_pHeader->dataOffset };
+
+	LoadState& state{ *m_pLoadState };
+	const BinaryObject& object{ pObjects[objectIndex] };
+
+	GameObject* pObject{};
+	if (object.parent != NoParent)
+	{
+		if (object.parent >= objectIndex)
+			throw ParsingError("Binary file object parent out of order");
+		pObject = state.pScene->CreateGameObject(state.createdObjects[object.parent]);
+	}
+	else if (state.pRoot)
+	{
+		if (objectIndex != 0)
+			throw ParsingError("Binary object file contains multiple root objects");
+		pObject = state.pRoot;
+	}
+	else
+	{
+		pObject = state.pScene->CreateGameObject();
+	}
+	state.createdObjects[objectIndex] = pObject;
+
+	state.deserializer.RegisterGameObject(object.streamId, pObject);
+	pObject->SetName(std::string(GetString(object.nameOffset, object.nameLength)));
+
+	if (object.firstComponent > m_pHeader->componentAmount || m_pHeader->componentAmount - object.firstComponent < object.componentAmount)
+		throw ParsingError("Binary file component out of bounds");
+
+	for (uint32_t i{ object.firstComponent }; i < object.firstComponent + object.componentAmount; ++i)
+	{
+		const BinaryComponent& component{ pComponents[i] };
+		if (component.typeIndex >= m_TypePlans.size())
+			throw ParsingError("Binary file component type out of bounds");
+
+		const TypePlan& plan{ m_TypePlans[component.typeIndex] };
+		if (component.dataOffset > m_pHeader->dataSize || m_pHeader->dataSize - component.dataOffset < plan.recordSize)
+			throw ParsingError("Binary file component data out of bounds");
+
+		ComponentBase* pComponent{ plan.pTypeInfo->componentGenerator(pObject) };
+		const uint8_t* pRecord{ pData + component.dataOffset };
+
+		for (uint32_t f{ plan.firstField }; f < plan.firstField + plan.fieldAmount; ++f)
+		{
+			const FieldPlan& field{ m_FieldPlans[f] };
+
+			if (!field.isText)
+			{
+				std::memcpy(reinterpret_cast<uint8_t*>(pComponent) + field.pInfo->offset, pRecord + field.recordOffset, field.size);
+				continue;
+			}
+
+			uint32_t textRange[2]{};
+			std::memcpy(textRange, pRecord + field.recordOffset, sizeof(textRange));
+			const std::string_view text{ GetString(textRange[0], textRange[1]) };
+
+			state.textBuffer.SetRange(text.data(), text.size());
+			state.textStream.clear();
+			field.pInfo->Deserialize(state.deserializer, pComponent);
+		}
+	}
+}
@@ -0,0 +1,167 @@
+﻿#pragma once
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+
+#include "EngineFiles/ComponentBase.h"
+
+class Scene;
+class GameObject;
+class MappedFile;
+
+/**
+ * Reads and writes the binary version of the .scene and .gobj files.
+ * The file starts with a table of the component types and their fields, followed by the objects in depth first order.
+ * Every component is a fixed size record, fields that are trivially copyable are stored as their raw bytes
+ * and get copied into the component with a memcpy when loading. Other fields (strings, resources, references)
+ * keep their text representation inside the file.
+ * The text files stay the files that get edited and diffed, the binary files are only for loading fast.
+ * Fields are matched by the hash of their name, so fields that were added or removed since the file was written
+ * are skipped just like with the text files. The file is little endian.
+ */
+class BinarySerializer final
+{
+public:
+
+	static constexpr uint32_t Version{ 1 };
+
+	BinarySerializer();
+	~BinarySerializer();
+
+	void SerializeScene(std::ostream& os, Scene* pScene);
+	void SerializeObject(std::ostream& os, GameObject* pObject);
+
+	/** Creates a new scene from a mapped binary scene file. Throws a ParsingError if the file is invalid.*/
+	Scene* DeserializeScene(const MappedFile& file);
+
+	/** Deserializes a mapped binary object file into the given pObject. Throws a ParsingError if the file is invalid.*/
+	GameObject* DeserializeObject(const MappedFile& file, GameObject* pObject);
+
+	/**
+	* Validates the file and builds the copy plans without touching any scene, so it may run on any thread.
+	* Loading the objects is split in the steps below so it can be spread over multiple frames, see SceneStreamer.
+	* Throws a ParsingError if the file is invalid.
+	*/
+	void Prepare(const MappedFile& file);
+	/** The object of an object file gets loaded into pRoot, the objects of a scene file get added to the top of pScene*/
+	void BeginLoading(Scene* pScene, GameObject* pRoot = nullptr);
+	/** Loads the next top level object together with its children. Returns false once every object is loaded*/
+	bool LoadSubtree();
+	/** Links the references between the loaded components*/
+	void EndLoading();
+
+	std::string_view GetSceneName() const { return GetString(m_pHeader->nameOffset, m_pHeader->nameLength); }
+	uint32_t GetObjectAmount() const { return m_pHeader ? m_pHeader->objectAmount : 0; }
+	uint32_t GetLoadedObjectAmount() const { return m_LoadedObjects; }
+
+private:
+
+	/** Every section only contains 32 bit values so the structs have no padding and can be read straight from the file*/
+	struct Header
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t typeAmount, typesOffset;
+		uint32_t fieldAmount, fieldsOffset;
+		uint32_t objectAmount, objectsOffset;
+		uint32_t componentAmount, componentsOffset;
+		uint32_t dataSize, dataOffset;
+		uint32_t stringsSize, stringsOffset;
+		/** Name of the scene inside of the strings*/
+		uint32_t nameOffset, nameLength;
+	};
+
+	struct BinaryType
+	{
+		uint32_t classId;
+		uint32_t firstField, fieldAmount;
+		uint32_t recordSize;
+	};
+
+	struct BinaryField
+	{
+		uint32_t nameHash;
+		uint32_t recordOffset;
+		/** Size inside of the record, a text field stores the offset and length of its text*/
+		uint32_t size;
+		uint32_t isText;
+	};
+
+	struct BinaryObject
+	{
+		uint32_t streamId;
+		/** Index of the parent object, NoParent for objects at the top of the scene*/
+		uint32_t parent;
+		uint32_t nameOffset, nameLength;
+		uint32_t firstComponent, componentAmount;
+	};
+
+	struct BinaryComponent
+	{
+		uint32_t typeIndex;
+		uint32_t dataOffset;
+	};
+
+	using FieldInfo = UserFieldBinder::FieldInfo;
+
+	/** How the fields of a type inside of the file get copied into a component, built once per type when loading*/
+	struct FieldPlan
+	{
+		const FieldInfo* pInfo;
+		uint32_t recordOffset;
+		uint32_t size;
+		bool isText;
+	};
+
+	struct TypePlan
+	{
+		TypeInformation::TypeInfo* pTypeInfo;
+		uint32_t firstField, fieldAmount;
+		uint32_t recordSize;
+	};
+
+	static constexpr uint32_t NoParent{ UINT32_MAX };
+
+private:
+
+	// WRITING
+	void BeginWriting();
+	uint32_t GetTypeIndex(const ComponentBase* pComponent);
+	uint32_t AddString(std::string_view string);
+	void AddObject(GameObject* pObject, uint32_t parent);
+	void Write(std::ostream& os, std::string_view name);
+
+	// READING
+	void ReadHeader(const MappedFile& file);
+	void BuildPlans();
+	std::string_view GetString(uint32_t offset, uint32_t length) const;
+	void LoadObject(uint32_t objectIndex);
+
+private:
+
+	std::vector<BinaryType> m_Types;
+	std::vector<BinaryField> m_Fields;
+	std::vector<const FieldInfo*> m_FieldInfos;
+	std::vector<BinaryObject> m_Objects;
+	std::vector<BinaryComponent> m_Components;
+	std::vector<uint8_t> m_Data;
+	std::string m_Strings;
+	std::unordered_map<uint32_t, uint32_t> m_TypeIndices;
+	std::ostringstream m_TextStream;
+
+	const uint8_t* m_pFile{};
+	const Header* m_pHeader{};
+	std::vector<TypePlan> m_TypePlans;
+	std::vector<FieldPlan> m_FieldPlans;
+
+	/** State of the objects that are being loaded, defined in the source file*/
+	struct LoadState;
+	std::unique_ptr<LoadState> m_pLoadState;
+	uint32_t m_LoadedObjects{};
+
+};
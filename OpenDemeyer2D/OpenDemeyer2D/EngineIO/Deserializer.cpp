@@ -76,22 +76,7 @@ void Deserializer::DeserializeGame(std::istream& iStream)
 
 			scene.Deserialize(*this);
 		}
-		for (auto& link : m_LinkingInfos)
-		{
-			auto it = m_RegisteredObjects.find(link.objectId);
-			if (it != m_RegisteredObjects.end())
-			{
-				auto pComp{ it->second->GetComponentById(link.typeId) };
-				if (pComp)
-				{
-					auto weakRef{ pComp->GetWeakReference() };
-					link.pointerLinker(&weakRef);
-				}
-			}
-		}
-
-		m_RegisteredObjects.clear();
-		m_LinkingInfos.clear();
+		LinkComponents();
 	}
 
 	m_pIStream = nullptr;
@@ -110,22 +95,7 @@ Scene* Deserializer::DeserializeScene(std::istream& iStream)
 		pScene->Deserialize(*this);
 	}
 
-	for (auto& link : m_LinkingInfos)
-	{
-		auto it = m_RegisteredObjects.find(link.objectId);
-		if (it != m_RegisteredObjects.end())
-		{
-			auto pComp{ it->second->GetComponentById(link.typeId) };
-			if(pComp)
-			{
-				auto weakRef{ pComp->GetWeakReference() };
-				link.pointerLinker(&weakRef);
-			}
-		}
-	}
-
-	m_RegisteredObjects.clear();
-	m_LinkingInfos.clear();
+	LinkComponents();
 	m_pIStream = nullptr;
 
 	return pScene;
@@ -142,6 +112,14 @@ GameObject* Deserializer::DeserializeObject(std::istream& iStream, GameObject* p
 		pObject->Deserialize(*this);
 	}
 
+	LinkComponents();
+	m_pIStream = nullptr;
+
+	return pObject;
+}
+
+void Deserializer::LinkComponents()
+{
 	for (auto& link : m_LinkingInfos)
 	{
 		auto it = m_RegisteredObjects.find(link.objectId);
@@ -158,9 +136,4 @@ GameObject* Deserializer::DeserializeObject(std::istream& iStream, GameObject* p
 
 	m_RegisteredObjects.clear();
 	m_LinkingInfos.clear();
-	m_pIStream = nullptr;
-
-	return pObject;
 }
-
-
@@ -12,6 +12,9 @@ class GameObject;
 
 class Deserializer
 {
+	friend class BinarySerializer;
+	friend class SceneStreamer;
+
 public:
 
 	/** 
@@ -34,6 +37,11 @@ public:
 
 	std::istream* GetStream() { return m_pIStream; }
 
+private:
+
+	/** Links the components that were requested before their object was registered and forgets all the registered objects*/
+	void LinkComponents();
+
 private:
 
 	/**
@@ -0,0 +1,190 @@
+﻿#include "pch.h"
+#include "SceneStreamer.h"
+
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+
+#include "BinarySerializer.h"
+#include "Deserializer.h"
+#include "EngineFiles/Scene.h"
+#include "EngineFiles/GameObject.h"
+#include "UtilityFiles/MappedFile.h"
+
+static size_t CountObjects(const GameObject* pObject)
+{
+	size_t amount{ 1 };
+	for (const GameObject* pChild : pObject->GetChildren())
+		amount += CountObjects(pChild);
+	return amount;
+}
+
+SceneStreamer::SceneStreamer(Scene* pScene, const std::filesystem::path& file, float frameBudget)
+	: m_pScene{ pScene }
+	, m_File{ file }
+	, m_FrameBudget{ frameBudget }
+	, m_IsBinary{ file.extension() == ".bscene" }
+{
+	assert(pScene);
+
+	m_Worker = std::jthread(&SceneStreamer::ReadFile, this);
+}
+
+SceneStreamer::~SceneStreamer() = default;
+
+void SceneStreamer::ReadFile()
+{
+	try
+	{
+		if (m_IsBinary)
+		{
+			m_pMappedFile = std::make_unique<MappedFile>(m_File);
+			m_pBinarySerializer = std::make_unique<BinarySerializer>();
+			m_pBinarySerializer->Prepare(*m_pMappedFile);
+
+			// touch every page so the main thread does not wait on the disk while copying the records
+			constexpr size_t pageSize{ 4096 };
+			volatile uint8_t touched{};
+			for (size_t offset{}; offset < m_pMappedFile->GetSize(); offset += pageSize)
+				touched = touched + m_pMappedFile->GetData()[offset];
+		}
+		else
+		{
+			std::ifstream is(m_File, std::ios::binary);
+			if (!is)
+				throw ParsingError("Could not open " + m_File.string());
+			m_Text.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+		}
+	}
+	catch (std::exception& exception)
+	{
+		m_Error = exception.what();
+		if (m_Error.empty())
+			m_Error = "Could not read " + m_File.string();
+	}
+
+	m_IsPrepared.store(true, std::memory_order_release);
+}
+
+bool SceneStreamer::Update()
+{
+	if (m_IsDone)
+		return true;
+	if (!m_IsPrepared.load(std::memory_order_acquire))
+		return false;
+
+	try
+	{
+		if (!m_HasBegun)
+		{
+			m_HasBegun = true;
+
+			if (!m_Error.empty())
+			{
+				m_IsDone = true;
+				return true;
+			}
+
+			if (m_IsBinary)
+			{
+				m_pBinarySerializer->BeginLoading(m_pScene);
+			}
+			else
+			{
+				m_TextStream.str(m_Text);
+				m_pDeserializer = std::make_unique<Deserializer>();
+				m_pDeserializer->m_pIStream = &m_TextStream;
+
+				// the objects get added to the live scene, the name of the scene in the file is skipped
+				std::string name;
+				m_TextStream >> name;
+				if (!CanContinue(m_TextStream))
+				{
+					Finish();
+					return true;
+				}
+			}
+		}
+
+		const auto start{ std::chrono::steady_clock::now() };
+		do
+		{
+			if (!LoadSubtree())
+			{
+				Finish();
+				return true;
+			}
+		} while (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() < m_FrameBudget);
+	}
+	catch (std::exception& exception)
+	{
+		m_Error = exception.what();
+		if (m_Error.empty())
+			m_Error = "Could not parse " + m_File.string();
+		m_IsDone = true;
+		return true;
+	}
+
+	return false;
+}
+
+float SceneStreamer::GetProgress() const
+{
+	if (m_IsDone)
+		return 1.f;
+	if (!m_HasBegun)
+		return 0.f;
+
+	if (m_IsBinary)
+	{
+		const uint32_t objectAmount{ m_pBinarySerializer->GetObjectAmount() };
+		return objectAmount ? float(m_pBinarySerializer->GetLoadedObjectAmount()) / float(objectAmount) : 1.f;
+	}
+
+	return m_Text.empty() ? 1.f : float(m_TextPosition) / float(m_Text.size());
+}
+
+bool SceneStreamer::LoadSubtree()
+{
+	if (m_IsBinary)
+	{
+		const uint32_t loadedObjects{ m_pBinarySerializer->GetLoadedObjectAmount() };
+		if (!m_pBinarySerializer->LoadSubtree())
+			return false;
+
+		m_LoadedObjects += m_pBinarySerializer->GetLoadedObjectAmount() - loadedObjects;
+		return true;
+	}
+
+	if (IsEnd(m_TextStream))
+		return false;
+
+	auto pObject{ m_pScene->CreateGameObject() };
+	pObject->Deserialize(*m_pDeserializer);
+
+	m_LoadedObjects += CountObjects(pObject);
+	m_TextPosition = size_t(std::max(std::streamoff(m_TextStream.tellg()), std::streamoff(0)));
+
+	return true;
+}
+
+void SceneStreamer::Finish()
+{
+	if (m_IsBinary)
+	{
+		m_pBinarySerializer->EndLoading();
+	}
+	else
+	{
+		m_pDeserializer->LinkComponents();
+		m_pDeserializer->m_pIStream = nullptr;
+	}
+
+	m_IsDone = true;
+
+	// the file is no longer needed once everything is loaded
+	m_Text = {};
+	m_TextStream = {};
+	m_pBinarySerializer.reset();
+	m_pMappedFile.reset();
+}
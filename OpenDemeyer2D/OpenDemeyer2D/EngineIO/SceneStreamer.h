@@ -0,0 +1,91 @@
+﻿#pragma once
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <sstream>
+
+class Scene;
+class Deserializer;
+class BinarySerializer;
+class MappedFile;
+
+/**
+ * Loads the objects of a scene file into a live scene over multiple frames.
+ * A worker thread reads the file (or maps and prefetches a binary file and builds its copy plans).
+ * Every Scene::PreUpdate the main thread then builds top level objects with their children until the frame budget is used.
+ * An object is only created when its whole subtree can be created in the same step, so the scene never holds half loaded objects.
+ * References between the objects are linked once the last object is loaded.
+ */
+class SceneStreamer final
+{
+public:
+
+	/** Milliseconds spent building objects every frame. At least one top level object is built every frame*/
+	static constexpr float DefaultFrameBudget{ 2.f };
+
+	/** Starts reading the file, .bscene files are loaded with the BinarySerializer and others as text*/
+	SceneStreamer(Scene* pScene, const std::filesystem::path& file, float frameBudget = DefaultFrameBudget);
+	~SceneStreamer();
+
+	SceneStreamer(const SceneStreamer&) = delete;
+	SceneStreamer(SceneStreamer&&) = delete;
+	SceneStreamer& operator=(const SceneStreamer&) = delete;
+	SceneStreamer& operator=(SceneStreamer&&) = delete;
+
+	/** Builds objects until the frame budget is used. Gets called by Scene::PreUpdate. Returns true once the streamer is done*/
+	bool Update();
+
+	void SetFrameBudget(float milliseconds) { m_FrameBudget = milliseconds; }
+	float GetFrameBudget() const { return m_FrameBudget; }
+
+	/** Returns how much of the file is loaded between 0 and 1*/
+	float GetProgress() const;
+
+	/** Returns true once every object is loaded or loading failed*/
+	bool IsDone() const { return m_IsDone; }
+	bool HasFailed() const { return !m_Error.empty(); }
+	const std::string& GetError() const { return m_Error; }
+
+	const std::filesystem::path& GetFile() const { return m_File; }
+
+	size_t GetLoadedObjectAmount() const { return m_LoadedObjects; }
+
+private:
+
+	void ReadFile();
+
+	/** Builds the next top level object with its children. Returns false when there are no objects left*/
+	bool LoadSubtree();
+
+	void Finish();
+
+private:
+
+	Scene* m_pScene{};
+	std::filesystem::path m_File;
+	float m_FrameBudget{};
+	bool m_IsBinary{};
+
+	// BINARY
+	std::unique_ptr<MappedFile> m_pMappedFile;
+	std::unique_ptr<BinarySerializer> m_pBinarySerializer;
+
+	// TEXT
+	std::string m_Text;
+	std::istringstream m_TextStream;
+	size_t m_TextPosition{};
+	std::unique_ptr<Deserializer> m_pDeserializer;
+
+	/** Set by the worker thread once the file is ready to be loaded*/
+	std::atomic<bool> m_IsPrepared{};
+	bool m_HasBegun{};
+	bool m_IsDone{};
+	std::string m_Error;
+	size_t m_LoadedObjects{};
+
+	/** Declared last so it is joined before the members it uses are destroyed*/
+	std::jthread m_Worker;
+
+};
@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <string>
 #include <cassert>
+#include <cstring>
+#include <vector>
 #include <type_traits>
 
 #include "UtilityFiles/Singleton.h"
@@ -23,6 +25,20 @@ class GameObject;
 template<typename T> struct is_weak_ptr : std::false_type {};
 template<typename T> struct is_weak_ptr<std::weak_ptr<T>> : std::true_type {};
 
+/**
+* Fields of these types are stored byte for byte in binary scene files and copied straight into the component when loaded.
+* Specialize to false for trivially copyable types that hold pointers, those fields are stored as text instead.
+*/
+template<typename T> struct is_binary_copyable : std::bool_constant<std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>> {};
+
+struct b2BodyDef;
+struct b2FixtureDef;
+template<> struct is_binary_copyable<b2BodyDef> : std::false_type {};
+template<> struct is_binary_copyable<b2FixtureDef> : std::false_type {};
+
+template<typename T> struct is_component_reference : std::false_type {};
+template<typename T> struct is_component_reference<std::weak_ptr<T>> : std::bool_constant<std::is_base_of_v<ComponentBase, T>> {};
+
 /**
 * Class responsible for keeping field information of a particular component
 */
@@ -44,6 +60,10 @@ private:
 		virtual void Serialize(std::ostream& os, const void* address) const = 0;
 		virtual void DeSerialize(Deserializer& is, void* address) const = 0;
 		virtual void Copy(const void* originalAddress, void* copyAddress, CopyLinker* copyLinker = nullptr) const = 0;
+
+		/** Returns the component that the field references, only for weak pointers to components*/
+		virtual ComponentBase* GetReference(const void* address) const = 0;
+		virtual void SetReference(void* address, ComponentBase* pTarget) const = 0;
 	};
 
 	template <typename T>
@@ -86,8 +106,24 @@ private:
 				*static_cast<T*>(copyAddress) = *static_cast<const T*>(originalAddress);
 			}
 		}
+
+		ComponentBase* GetReference(const void* address) const override
+		{
+			if constexpr (is_component_reference<T>::value)
+				return static_cast<const T*>(address)->lock().get();
+			else
+				return nullptr;
+		}
+
+		void SetReference(void* address, ComponentBase* pTarget) const override
+		{
+			if constexpr (is_component_reference<T>::value)
+				*static_cast<T*>(address) = static_cast<typename T::element_type*>(pTarget)->GetWeakReferenceType();
+		}
 	};
 
+public:
+
 	/**
 	* Class responsible for keeping field info.
 	*/
@@ -97,6 +133,12 @@ private:
 		size_t offset{};
 		/** Size of the field*/
 		size_t size{};
+		/** If the field can be copied byte for byte, see is_binary_copyable*/
+		bool isBinaryCopyable{};
+		/** If copying the field is the same as a memcpy, these fields are copied in spans when cloning*/
+		bool isTriviallyCopyable{};
+		/** If the field is a weak pointer to a component, see is_component_reference*/
+		bool isComponentReference{};
 		/** Serializer containing functions for serializing, deserializing and copying fields*/
 		std::shared_ptr<FieldSerializerBase> pSerializer{};
 
@@ -118,6 +160,31 @@ private:
 			size_t Copyaddress = reinterpret_cast<size_t>(copyComponent) + offset;
 			pSerializer->Copy(reinterpret_cast<void*>(Originaladdress), reinterpret_cast<void*>(Copyaddress), copyLinker);
 		}
+
+		ComponentBase* GetReference(const ComponentBase* pComponent) const
+		{
+			size_t address = reinterpret_cast<size_t>(pComponent) + offset;
+			return pSerializer->GetReference(reinterpret_cast<const void*>(address));
+		}
+
+		void SetReference(ComponentBase* pComponent, ComponentBase* pTarget) const
+		{
+			size_t address = reinterpret_cast<size_t>(pComponent) + offset;
+			pSerializer->SetReference(reinterpret_cast<void*>(address), pTarget);
+		}
+	};
+
+	struct Field final
+	{
+		std::string name;
+		FieldInfo info;
+	};
+
+	/** Range of trivially copyable fields that directly follow each other inside of the class*/
+	struct CopySpan final
+	{
+		size_t offset{};
+		size_t size{};
 	};
 
 public:
@@ -127,15 +194,82 @@ public:
 	void Add(const std::string& identifier, size_t fieldOffset)
 	{
 		assert(std::find_if(identifier.begin(), identifier.end(), [](char c) {return isspace(c); }) == identifier.end());
-		FieldInfo info = FieldInfo{fieldOffset, sizeof(Type), std::shared_ptr<FieldSerializerBase>(new FieldSerializer<Type>()) };
-		m_UserFields.insert({ identifier, std::move(info) });
+		assert(!FindField(identifier));
+		constexpr bool isTriviallyCopyable{ std::is_trivially_copyable_v<Type> && !std::is_pointer_v<Type> };
+		FieldInfo info = FieldInfo{fieldOffset, sizeof(Type), is_binary_copyable<Type>::value, isTriviallyCopyable, is_component_reference<Type>::value, std::shared_ptr<FieldSerializerBase>(new FieldSerializer<Type>()) };
+		m_FieldIndices.insert({ identifier, m_Fields.size() });
+		m_Fields.emplace_back(Field{ identifier, std::move(info) });
+	}
+
+	/**
+	* Orders the fields on their offset and merges the trivially copyable fields that follow each other into copy spans.
+	* Only the fields that are not trivially copyable keep their own copy function. Gets called once when the type is registered.
+	*/
+	void CompilePlan()
+	{
+		std::stable_sort(m_Fields.begin(), m_Fields.end(), [](const Field& lhs, const Field& rhs) { return lhs.info.offset < rhs.info.offset; });
+
+		m_FieldIndices.clear();
+		m_CopySpans.clear();
+		m_CustomFields.clear();
+
+		for (size_t i{}; i < m_Fields.size(); ++i)
+		{
+			const FieldInfo& info{ m_Fields[i].info };
+			m_FieldIndices.insert({ m_Fields[i].name, i });
+
+			if (!info.isTriviallyCopyable)
+				m_CustomFields.emplace_back(i);
+			else if (!m_CopySpans.empty() && m_CopySpans.back().offset + m_CopySpans.back().size == info.offset)
+				m_CopySpans.back().size += info.size;
+			else
+				m_CopySpans.emplace_back(CopySpan{ info.offset, info.size });
+		}
+	}
+
+	/** Returns the fields ordered on their offset*/
+	const std::vector<Field>& GetFields() const { return m_Fields; }
+
+	const FieldInfo* FindField(const std::string& identifier) const
+	{
+		auto it = m_FieldIndices.find(identifier);
+		return it != m_FieldIndices.end() ? &m_Fields[it->second].info : nullptr;
+	}
+
+	const std::vector<CopySpan>& GetCopySpans() const { return m_CopySpans; }
+
+	/** Writes every field as its name followed by its value*/
+	void Serialize(std::ostream& os, const ComponentBase* pComponent) const
+	{
+		for (auto& field : m_Fields)
+		{
+			os << field.name << ' ';
+			field.info.Serialize(os, pComponent);
+			os << '\n';
+		}
 	}
 
-	const std::unordered_map<std::string, FieldInfo>& GetFields() const { return m_UserFields; }
+	/** Copies the spans with a memcpy each and the remaining fields with their own copy function*/
+	void Copy(const ComponentBase* pOriginal, ComponentBase* pCopy, CopyLinker* copyLinker = nullptr) const
+	{
+		auto pOriginalBytes{ reinterpret_cast<const char*>(pOriginal) };
+		auto pCopyBytes{ reinterpret_cast<char*>(pCopy) };
+
+		for (auto& span : m_CopySpans)
+			std::memcpy(pCopyBytes + span.offset, pOriginalBytes + span.offset, span.size);
+
+		for (size_t index : m_CustomFields)
+			m_Fields[index].info.Copy(pOriginal, pCopy, copyLinker);
+	}
 
 private:
 
-	std::unordered_map<std::string, FieldInfo> m_UserFields;
+	std::vector<Field> m_Fields;
+	std::unordered_map<std::string, size_t> m_FieldIndices;
+
+	std::vector<CopySpan> m_CopySpans;
+	/** Indices of the fields that are not trivially copyable*/
+	std::vector<size_t> m_CustomFields;
 
 };
 
@@ -144,6 +278,15 @@ class TypeIdentifier final
 {
 public:
 
+	/**
+	* The hooks that T overrides.
+	* A member function pointer to a hook that is not overridden still has ComponentBase as its class type.
+	*/
+	static constexpr ComponentHooks Hooks{
+		!std::is_same_v<decltype(&T::Update), void (ComponentBase::*)(float)>,
+		!std::is_same_v<decltype(&T::LateUpdate), void (ComponentBase::*)()>,
+		!std::is_same_v<decltype(&T::BeginPlay), void (ComponentBase::*)()> };
+
 	TypeIdentifier()
 	{
 		auto& instance = TypeInformation::GetInstance();
@@ -168,6 +311,7 @@ public:
 		UserFieldBinder binder{};
 		T object{};
 		object.DefineUserFields(binder);
+		binder.CompilePlan();
 
 		instance.AddTypeInfo(hash(name), {name,generator,binder});
 	}
@@ -125,9 +125,11 @@ void ImageDetailView::RenderDetails()
 	ImGui::Text("Height: [%d]", m_Texture->GetHeight());
 
 	float width = ImGui::GetWindowWidth() - 20.f;
+	glm::vec2 uv0 = m_Texture->GetPageUV({ 0.f, 0.f });
+	glm::vec2 uv1 = m_Texture->GetPageUV({ m_Texture->GetWidth(), m_Texture->GetHeight() });
 
 #pragma warning(disable : 4312)
-	ImGui::Image((ImTextureID)(m_Texture->GetId()), { width,width / m_Texture->GetWidth() * m_Texture->GetHeight() });
+	ImGui::Image((ImTextureID)(m_Texture->GetId()), { width,width / m_Texture->GetWidth() * m_Texture->GetHeight() }, { uv0.x, uv0.y }, { uv1.x, uv1.y });
 #pragma warning(default : 4312)
 }
 
@@ -279,6 +281,18 @@ void PrefabDetailView::RenderDetails()
 	{
 		RenderGameObject(m_Prefab->GetGameObject());
 	}
+
+	if (ImGui::Button("Convert to Binary"))
+	{
+		try
+		{
+			RESOURCES.ConvertToBinary(m_Path);
+		}
+		catch (std::exception&)
+		{
+
+		}
+	}
 }
 
 constexpr std::string_view PrefabDetailView::GetFileClass()
@@ -318,6 +332,35 @@ void SceneDetailView::RenderDetails()
 		catch (std::exception&)
 		{
 			
+		}
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Stream Scene"))
+	{
+		SCENES.SetActiveScene(RESOURCES.StreamScene(m_Path));
+	}
+
+	if (ImGui::Button("Convert to Binary"))
+	{
+		try
+		{
+			RESOURCES.ConvertToBinary(m_Path);
+		}
+		catch (std::exception&)
+		{
+
+		}
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Convert to Text"))
+	{
+		try
+		{
+			RESOURCES.ConvertToText(m_Path);
+		}
+		catch (std::exception&)
+		{
+
 		}
 	}
 }
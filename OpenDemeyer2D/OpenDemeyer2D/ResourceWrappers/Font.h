@@ -3,6 +3,8 @@
 #include <SDL_ttf.h>
 #include <stdexcept>
 #include <filesystem>
+#include <memory>
+#include "GlyphCache.h"
 
 struct _TTF_Font;
 
@@ -31,8 +33,19 @@ public:
 
 	const std::filesystem::path& GetPath() const { return m_Path; }
 
+	/** Returns the cache of rasterized glyphs of this font, it gets created the first time it is needed*/
+	GlyphCache& GetGlyphCache()
+	{
+		if (!m_pGlyphCache)
+			m_pGlyphCache = std::make_unique<GlyphCache>(m_Font);
+		return *m_pGlyphCache;
+	}
+
+	const GlyphCache* TryGetGlyphCache() const { return m_pGlyphCache.get(); }
+
 	~Font()
 	{
+		m_pGlyphCache.reset();
 		TTF_CloseFont(m_Font);
 	}
 
@@ -47,4 +60,5 @@ private:
 	_TTF_Font* m_Font;
 	unsigned int m_Size;
 	std::filesystem::path m_Path;
+	std::unique_ptr<GlyphCache> m_pGlyphCache;
 };
\ No newline at end of file
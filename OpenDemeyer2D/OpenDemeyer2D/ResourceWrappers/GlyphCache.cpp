@@ -0,0 +1,139 @@
+﻿#include "pch.h"
+#include "GlyphCache.h"
+
+#include <SDL_ttf.h>
+#include <algorithm>
+#include <cstring>
+
+#include "ResourceWrappers/Texture2D.h"
+#include "Singletons/RenderManager.h"
+
+GlyphCache::GlyphCache(_TTF_Font* pFont)
+	: m_pFont{ pFont }
+	, m_Texture{ std::make_shared<Texture2D>() }
+{
+	GLuint id{};
+	glGenTextures(1, &id);
+	glBindTexture(GL_TEXTURE_2D, id);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	*m_Texture = Texture2D(id, TextureWidth, 0);
+
+	// Start with room for a few lines of glyphs
+	Grow(std::max(TTF_FontHeight(m_pFont) + 2 * Padding, 16) * 4);
+}
+
+GlyphCache::~GlyphCache() = default;
+
+glm::vec2 GlyphCache::Layout(std::string_view text, FrameVector<RenderQuad>& quads)
+{
+	++m_LayoutCount;
+	m_CharacterCount += text.size();
+
+	const bool hasKerning{ TTF_GetFontKerning(m_pFont) != 0 };
+
+	int penX{};
+	int width{};
+	Uint16 previous{};
+
+	for (char c : text)
+	{
+		const Uint16 character{ Uint16(static_cast<unsigned char>(c)) };
+		const Glyph& glyph = GetGlyph(character);
+
+		if (hasKerning && previous)
+			penX += TTF_GetFontKerningSizeGlyphs(m_pFont, previous, character);
+		previous = character;
+
+		if (glyph.rect.w > 0)
+		{
+			quads.emplace_back(RenderQuad{
+				SDL_FRect{ float(glyph.rect.x), float(glyph.rect.y), float(glyph.rect.w), float(glyph.rect.h) },
+				glm::vec2{ float(penX), 0.f } });
+
+			width = std::max(width, penX + glyph.rect.w);
+		}
+
+		penX += glyph.advance;
+	}
+
+	return { float(std::max(width, penX)), float(TTF_FontHeight(m_pFont)) };
+}
+
+const GlyphCache::Glyph& GlyphCache::GetGlyph(Uint16 character)
+{
+	auto it = m_Glyphs.find(character);
+	if (it != m_Glyphs.end())
+		return it->second;
+
+	Glyph glyph{};
+
+	int minX{}, maxX{}, minY{}, maxY{};
+	TTF_GlyphMetrics(m_pFont, character, &minX, &maxX, &minY, &maxY, &glyph.advance);
+
+	// Rasterized in white so the text color can be the tint, the surface is as high as the font so every glyph shares the baseline
+	SDL_Surface* pGlyphSurface{ TTF_RenderGlyph_Blended(m_pFont, character, SDL_Color{ 255,255,255,255 }) };
+	SDL_Surface* pConverted{ pGlyphSurface ? SDL_ConvertSurfaceFormat(pGlyphSurface, SDL_PIXELFORMAT_RGBA32, 0) : nullptr };
+	SDL_FreeSurface(pGlyphSurface);
+
+	// Glyphs wider than the texture are left out, only their advance is kept
+	if (pConverted && pConverted->w > 0 && pConverted->h > 0 && pConverted->w + 2 * Padding <= TextureWidth)
+	{
+		const glm::ivec2 offset{ Pack({ pConverted->w, pConverted->h }) };
+		glyph.rect = { offset.x, offset.y, pConverted->w, pConverted->h };
+
+		for (int y{}; y < pConverted->h; ++y)
+		{
+			std::memcpy(&m_Pixels[size_t(offset.y + y) * TextureWidth + offset.x],
+				static_cast<const uint8_t*>(pConverted->pixels) + size_t(y) * pConverted->pitch, size_t(pConverted->w) * 4);
+		}
+
+		glBindTexture(GL_TEXTURE_2D, m_Texture->GetId());
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, pConverted->pitch / 4);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, offset.x, offset.y, pConverted->w, pConverted->h, GL_RGBA, GL_UNSIGNED_BYTE, pConverted->pixels);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	SDL_FreeSurface(pConverted);
+
+	return m_Glyphs.emplace(character, glyph).first->second;
+}
+
+glm::ivec2 GlyphCache::Pack(const glm::ivec2& size)
+{
+	const glm::ivec2 paddedSize{ size + 2 * Padding };
+
+	// Start a new shelf when the glyph does not fit on the current one anymore
+	if (m_ShelfPosition.x + paddedSize.x > TextureWidth)
+	{
+		m_ShelfPosition = { 0, m_ShelfPosition.y + m_ShelfHeight };
+		m_ShelfHeight = 0;
+	}
+
+	m_ShelfHeight = std::max(m_ShelfHeight, paddedSize.y);
+
+	const int textureHeight{ m_Texture->GetHeight() };
+	if (m_ShelfPosition.y + m_ShelfHeight > textureHeight)
+		Grow(std::max(textureHeight * 2, m_ShelfPosition.y + m_ShelfHeight));
+
+	const glm::ivec2 offset{ m_ShelfPosition + Padding };
+	m_ShelfPosition.x += paddedSize.x;
+
+	return offset;
+}
+
+void GlyphCache::Grow(int height)
+{
+	m_Pixels.resize(size_t(TextureWidth) * size_t(height));
+
+	// The GL texture keeps its id, so the texture handed out to the render components stays the same
+	glBindTexture(GL_TEXTURE_2D, m_Texture->GetId());
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, TextureWidth, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_Pixels.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	m_Texture->m_Height = height;
+	m_Texture->m_PageSize = { TextureWidth, height };
+}
@@ -0,0 +1,90 @@
+﻿#pragma once
+#include <gl/glew.h>
+#include <SDL.h>
+#include <memory>
+#include <vector>
+#include <string_view>
+#include <unordered_map>
+#include "glm/glm.hpp"
+
+#include "Allocators/FrameAllocator.h"
+
+struct _TTF_Font;
+struct RenderQuad;
+class Texture2D;
+
+/**
+ * Rasterizes every glyph of a font once, the first time it is used, onto a texture shared by all text using the font.
+ * Glyphs are rasterized in white so the color of the text can be applied as a tint.
+ * The glyphs are packed on shelves. When the texture is full it grows in height and every glyph keeps its place,
+ * so layouts made before the growth stay valid.
+ */
+class GlyphCache final
+{
+	struct Glyph
+	{
+		SDL_Rect rect{};
+		int advance{};
+	};
+
+public:
+
+	/** Width of the texture in pixels, the height grows with the amount of glyphs*/
+	static constexpr int TextureWidth{ 512 };
+
+	/** Empty pixels around every glyph so neighbours do not bleed into each other*/
+	static constexpr int Padding{ 1 };
+
+	explicit GlyphCache(_TTF_Font* pFont);
+	~GlyphCache();
+
+	GlyphCache(const GlyphCache&) = delete;
+	GlyphCache(GlyphCache&&) = delete;
+	GlyphCache& operator=(const GlyphCache&) = delete;
+	GlyphCache& operator=(GlyphCache&&) = delete;
+
+	/**
+	 * Lays the text out on a single line with kerning and appends a quad for every visible glyph.
+	 * Glyphs that are not cached yet are rasterized. Returns the size of the text in pixels.
+	 */
+	glm::vec2 Layout(std::string_view text, FrameVector<RenderQuad>& quads);
+
+	/** The texture the source rectangles of the laid out quads point into*/
+	const std::shared_ptr<Texture2D>& GetTexture() const { return m_Texture; }
+
+	size_t GetGlyphAmount() const { return m_Glyphs.size(); }
+
+	/** Returns the amount of times a text was laid out with this cache.*/
+	size_t GetLayoutCount() const { return m_LayoutCount; }
+
+	/** Returns the amount of characters laid out with this cache, including the ones that did not need to be rasterized.*/
+	size_t GetCharacterCount() const { return m_CharacterCount; }
+
+private:
+
+	const Glyph& GetGlyph(Uint16 character);
+
+	/** Finds a place for the size on the shelves, grows the texture if there is no room left. The padded width has to fit in TextureWidth*/
+	glm::ivec2 Pack(const glm::ivec2& size);
+
+	/** Makes the texture at least the given height, the pixels of the cached glyphs are uploaded again*/
+	void Grow(int height);
+
+private:
+
+	_TTF_Font* m_pFont{};
+
+	std::shared_ptr<Texture2D> m_Texture;
+
+	/** Copy of the texture so it can grow without losing the glyphs*/
+	std::vector<uint32_t> m_Pixels;
+
+	std::unordered_map<Uint16, Glyph> m_Glyphs;
+
+	glm::ivec2 m_ShelfPosition{};
+	int m_ShelfHeight{};
+
+	size_t m_LayoutCount{};
+	size_t m_CharacterCount{};
+
+};
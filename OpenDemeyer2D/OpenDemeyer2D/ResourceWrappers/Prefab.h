@@ -1,7 +1,9 @@
 #pragma once
 #include "EngineFiles/GameObject.h"
 #include "EngineFiles/Scene.h"
+#include "PrefabTemplate.h"
 #include <memory>
+#include <vector>
 #include <filesystem>
 
 class Prefab final
@@ -14,7 +16,10 @@ public:
 
 	Prefab(GameObject* object)
 		: m_Object{ object }
-	{}
+	{
+		if (m_Object)
+			m_Template.Compile(m_Object);
+	}
 
 	~Prefab() = default;
 
@@ -24,16 +29,31 @@ public:
 	Prefab(Prefab&& other) noexcept
 		: m_Object{ std::move(other.m_Object) }
 		, m_sourceFile{ std::move(other.m_sourceFile) }
+		, m_Template{ std::move(other.m_Template) }
 	{}
 
 	Prefab& operator=(Prefab&& other) noexcept
 	{
 		m_Object = other.m_Object;
 		m_sourceFile = std::move(other.m_sourceFile);
+		m_Template = std::move(other.m_Template);
 		return *this;
 	}
 
+	/** Instantiates the prefab through its compiled template, see PrefabTemplate*/
 	GameObject* Instantiate(Scene* pScene) const
+	{
+		return m_Template.Instantiate(pScene);
+	}
+
+	/** Instantiates the prefab amount times and adds the new objects to instances*/
+	void Instantiate(Scene* pScene, size_t amount, std::vector<GameObject*>& instances) const
+	{
+		m_Template.Instantiate(pScene, amount, instances);
+	}
+
+	/** Instantiates the prefab by copying its object, which is what the template replaces*/
+	GameObject* InstantiateCopy(Scene* pScene) const
 	{
 		CopyLinker linker{};
 		GameObject* go = pScene->CreateGameObject();
@@ -41,6 +61,8 @@ public:
 		return go;
 	}
 
+	const PrefabTemplate& GetTemplate() const { return m_Template; }
+
 	GameObject* GetGameObject()
 	{
 		return m_Object;
@@ -53,6 +75,7 @@ public:
 
 private:
 
-	GameObject* m_Object;
+	GameObject* m_Object{};
 	std::filesystem::path m_sourceFile{};
+	PrefabTemplate m_Template{};
 };
\ No newline at end of file
@@ -0,0 +1,180 @@
+﻿#include "pch.h"
+#include "PrefabTemplate.h"
+
+#include <cstring>
+#include <unordered_map>
+
+#include "EngineFiles/GameObject.h"
+#include "EngineFiles/Scene.h"
+#include "EngineFiles/ComponentBase.h"
+
+void PrefabTemplate::Compile(const GameObject* pRoot)
+{
+	assert(pRoot);
+
+	Clear();
+	AddNode(pRoot, NoParent);
+	ResolvePatches();
+}
+
+void PrefabTemplate::Compile(const std::vector<GameObject*>& roots)
+{
+	Clear();
+	for (const GameObject* pRoot : roots)
+		AddNode(pRoot, NoParent);
+	ResolvePatches();
+}
+
+void PrefabTemplate::ResolvePatches()
+{
+	std::unordered_map<const GameObject*, uint32_t> nodeIndices{};
+	nodeIndices.reserve(m_Nodes.size());
+	for (uint32_t nodeIndex{}; nodeIndex < m_Nodes.size(); ++nodeIndex)
+		nodeIndices.emplace(m_Nodes[nodeIndex].pSource, nodeIndex);
+
+	for (uint32_t componentIndex{}; componentIndex < m_Components.size(); ++componentIndex)
+	{
+		const Component& component{ m_Components[componentIndex] };
+
+		auto& fields = component.pFields->GetFields();
+		for (uint32_t fieldIndex{}; fieldIndex < fields.size(); ++fieldIndex)
+		{
+			auto& field = fields[fieldIndex];
+			if (!field.info.isComponentReference)
+				continue;
+
+			const ComponentBase* pTarget{ field.info.GetReference(component.pSource) };
+			if (!pTarget)
+				continue;
+
+			auto it = nodeIndices.find(pTarget->GetGameObject());
+			if (it != nodeIndices.end())
+				m_Patches.emplace_back(Patch{ componentIndex, it->second, pTarget->GetComponentId(), fieldIndex });
+		}
+	}
+
+	m_Instances.resize(m_Nodes.size());
+	m_InstanceComponents.resize(m_Components.size());
+}
+
+void PrefabTemplate::Clear()
+{
+	m_Nodes.clear();
+	m_Components.clear();
+	m_CopyFields.clear();
+	m_Patches.clear();
+	m_Image.clear();
+	m_Instances.clear();
+	m_InstanceComponents.clear();
+}
+
+void PrefabTemplate::AddNode(const GameObject* pObject, uint32_t parent)
+{
+	const uint32_t nodeIndex{ uint32_t(m_Nodes.size()) };
+	m_Nodes.emplace_back(Node{ parent, uint32_t(m_Components.size()), 0, pObject });
+
+	auto& types = TypeInformation::GetInstance();
+
+	for (auto& [id, pComponent] : const_cast<GameObject*>(pObject)->GetComponents())
+	{
+		auto typeInfo = types.GetTypeInfo(pComponent->GetComponentId());
+		assert(typeInfo);
+
+		Component component{ &typeInfo->componentGenerator, &typeInfo->field, uint32_t(m_Image.size()), uint32_t(m_CopyFields.size()), 0, pComponent };
+
+		auto pSourceBytes{ reinterpret_cast<const uint8_t*>(pComponent) };
+		for (auto& span : typeInfo->field.GetCopySpans())
+			m_Image.insert(m_Image.end(), pSourceBytes + span.offset, pSourceBytes + span.offset + span.size);
+
+		// references get patched or stay empty, the other fields copy themselves
+		auto& fields = typeInfo->field.GetFields();
+		for (uint32_t fieldIndex{}; fieldIndex < fields.size(); ++fieldIndex)
+		{
+			if (fields[fieldIndex].info.isTriviallyCopyable || fields[fieldIndex].info.isComponentReference)
+				continue;
+
+			m_CopyFields.emplace_back(fieldIndex);
+			++component.fieldAmount;
+		}
+
+		m_Components.emplace_back(component);
+	}
+
+	m_Nodes[nodeIndex].componentAmount = uint32_t(m_Components.size()) - m_Nodes[nodeIndex].firstComponent;
+
+	for (const GameObject* pChild : pObject->GetChildren())
+		AddNode(pChild, nodeIndex);
+}
+
+GameObject* PrefabTemplate::Instantiate(Scene* pScene) const
+{
+	assert(IsCompiled());
+
+	pScene->ReserveGameObjects(m_Nodes.size(), 1);
+	return InstantiateNodes(pScene);
+}
+
+void PrefabTemplate::InstantiateAll(Scene* pScene) const
+{
+	if (m_Nodes.empty())
+		return;
+
+	size_t rootAmount{};
+	for (auto& node : m_Nodes)
+		rootAmount += node.parent == NoParent;
+
+	pScene->ReserveGameObjects(m_Nodes.size(), rootAmount);
+	InstantiateNodes(pScene);
+}
+
+void PrefabTemplate::Instantiate(Scene* pScene, size_t amount, std::vector<GameObject*>& instances) const
+{
+	assert(IsCompiled());
+
+	pScene->ReserveGameObjects(m_Nodes.size() * amount, amount);
+	instances.reserve(instances.size() + amount);
+
+	for (size_t i{}; i < amount; ++i)
+		instances.emplace_back(InstantiateNodes(pScene));
+}
+
+GameObject* PrefabTemplate::InstantiateNodes(Scene* pScene) const
+{
+	for (size_t nodeIndex{}; nodeIndex < m_Nodes.size(); ++nodeIndex)
+	{
+		const Node& node{ m_Nodes[nodeIndex] };
+
+		GameObject* pObject{ pScene->CreateGameObject(node.parent != NoParent ? m_Instances[node.parent] : nullptr) };
+		m_Instances[nodeIndex] = pObject;
+
+		pObject->SetName(node.pSource->GetName());
+		pObject->SetTag(node.pSource->GetTag());
+
+		for (uint32_t i{ node.firstComponent }; i < node.firstComponent + node.componentAmount; ++i)
+		{
+			const Component& component{ m_Components[i] };
+			ComponentBase* pComponent{ (*component.pGenerator)(pObject) };
+			m_InstanceComponents[i] = pComponent;
+
+			auto pBytes{ reinterpret_cast<uint8_t*>(pComponent) };
+			const uint8_t* pImage{ m_Image.data() + component.imageOffset };
+			for (auto& span : component.pFields->GetCopySpans())
+			{
+				std::memcpy(pBytes + span.offset, pImage, span.size);
+				pImage += span.size;
+			}
+
+			auto& fields = component.pFields->GetFields();
+			for (uint32_t f{ component.firstField }; f < component.firstField + component.fieldAmount; ++f)
+				fields[m_CopyFields[f]].info.Copy(component.pSource, pComponent);
+		}
+	}
+
+	for (auto& patch : m_Patches)
+	{
+		if (ComponentBase* pTarget{ m_Instances[patch.targetNode]->GetComponentById(patch.targetTypeId) })
+			m_Components[patch.component].pFields->GetFields()[patch.field].info.SetReference(m_InstanceComponents[patch.component], pTarget);
+	}
+
+	return m_Instances.front();
+}
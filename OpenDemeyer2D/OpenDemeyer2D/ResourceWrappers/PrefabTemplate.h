@@ -0,0 +1,94 @@
+﻿#pragma once
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+class GameObject;
+class Scene;
+class ComponentBase;
+class UserFieldBinder;
+
+/**
+ * Flat version of a prefab that gets compiled once when the prefab is loaded.
+ * It holds the objects of the prefab in depth first order, a byte image of the trivially copyable fields of every component
+ * and a patch table for the references between the components of the prefab.
+ * Instantiating adds the components, copies the images into their copy spans and patches the references,
+ * without the CopyLinker and its linking actions that GameObject::Copy needs.
+ * References to components outside of the prefab stay empty, just like when copying the prefab into another scene.
+ * The SceneManager compiles the top level objects of a scene into a template as well to start playing it.
+ */
+class PrefabTemplate final
+{
+	struct Node
+	{
+		/** Index of the parent node, NoParent for the root*/
+		uint32_t parent;
+		uint32_t firstComponent, componentAmount;
+		const GameObject* pSource;
+	};
+
+	struct Component
+	{
+		const std::function<ComponentBase* (GameObject*)>* pGenerator;
+		const UserFieldBinder* pFields;
+		/** Offset of the copy spans of the component inside of m_Image*/
+		uint32_t imageOffset;
+		/** Fields that are neither trivially copyable nor patched, copied from the source component*/
+		uint32_t firstField, fieldAmount;
+		const ComponentBase* pSource;
+	};
+
+	struct Patch
+	{
+		uint32_t component;
+		uint32_t targetNode;
+		uint32_t targetTypeId;
+		uint32_t field;
+	};
+
+	static constexpr uint32_t NoParent{ UINT32_MAX };
+
+public:
+
+	/** Compiles the object and its children. The object has to stay alive for as long as the template is used.*/
+	void Compile(const GameObject* pRoot);
+	/** Compiles multiple top level objects, references between all of them get patched. Used to snapshot whole scenes.*/
+	void Compile(const std::vector<GameObject*>& roots);
+	void Clear();
+
+	bool IsCompiled() const { return !m_Nodes.empty(); }
+
+	GameObject* Instantiate(Scene* pScene) const;
+
+	/** Instantiates the template amount times and adds the new root objects to instances*/
+	void Instantiate(Scene* pScene, size_t amount, std::vector<GameObject*>& instances) const;
+
+	/** Instantiates every top level object of a template that was compiled from multiple objects*/
+	void InstantiateAll(Scene* pScene) const;
+
+	size_t GetNodeAmount() const { return m_Nodes.size(); }
+	size_t GetComponentAmount() const { return m_Components.size(); }
+	size_t GetPatchAmount() const { return m_Patches.size(); }
+	size_t GetImageSize() const { return m_Image.size(); }
+
+private:
+
+	void AddNode(const GameObject* pObject, uint32_t parent);
+	void ResolvePatches();
+
+	GameObject* InstantiateNodes(Scene* pScene) const;
+
+private:
+
+	std::vector<Node> m_Nodes;
+	std::vector<Component> m_Components;
+	/** Indices into the fields of the component type*/
+	std::vector<uint32_t> m_CopyFields;
+	std::vector<Patch> m_Patches;
+	std::vector<uint8_t> m_Image;
+
+	/** The objects and components created by the instantiation that is running, indexed like m_Nodes and m_Components*/
+	mutable std::vector<GameObject*> m_Instances;
+	mutable std::vector<ComponentBase*> m_InstanceComponents;
+
+};
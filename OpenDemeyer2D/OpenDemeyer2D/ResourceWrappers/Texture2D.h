@@ -1,12 +1,20 @@
 #pragma once
 #include <gl/glew.h>
 #include <filesystem>
+#include <atomic>
+#include "glm/glm.hpp"
 
-/** Simple RAII container for the sdl texture*/
+/**
+ * Simple RAII container for the sdl texture
+ * The texture can also be a view of an area on a TextureAtlas page, in which case it does not own the GL texture.
+ */
 class Texture2D final
 {
 	friend class RenderManager;
 	friend class ResourceManager;
+	friend class TextureAtlas;
+	friend class TextureUploader;
+	friend class GlyphCache;
 
 public:
 	//SDL_Texture* GetSDLTexture() const { return m_Texture; }
@@ -19,6 +27,10 @@ public:
 		: m_Id{ other.m_Id }
 		, m_Width{ other.m_Width }
 		, m_Height{ other.m_Height }
+		, m_PageOffset{ other.m_PageOffset }
+		, m_PageSize{ other.m_PageSize }
+		, m_OwnsTexture{ other.m_OwnsTexture }
+		, m_HasFailed{ other.m_HasFailed.load() }
 		, m_sourceFile{ std::move(other.m_sourceFile) }
 	{
 		other.m_Id = 0;
@@ -34,28 +46,59 @@ public:
 		other.m_Width = 0;
 		m_Height = other.m_Height;
 		other.m_Height = 0;
+		m_PageOffset = other.m_PageOffset;
+		m_PageSize = other.m_PageSize;
+		m_OwnsTexture = other.m_OwnsTexture;
+		m_HasFailed = other.m_HasFailed.load();
 		m_sourceFile = std::move(other.m_sourceFile);
 		return *this;
 	}
 
 	explicit Texture2D(GLuint id, int width, int height)
-		: m_Id{ id }, m_Width{ width }, m_Height{ height }{}
-	~Texture2D(){ glDeleteTextures(1, &m_Id); }
+		: m_Id{ id }, m_Width{ width }, m_Height{ height }, m_PageSize{ width, height }{}
 
+	/** Creates a view of an area of an atlas page*/
+	explicit Texture2D(GLuint pageId, int width, int height, const glm::ivec2& pageOffset, const glm::ivec2& pageSize)
+		: m_Id{ pageId }, m_Width{ width }, m_Height{ height }, m_PageOffset{ pageOffset }, m_PageSize{ pageSize }, m_OwnsTexture{ false }{}
+
+	~Texture2D(){ if (m_OwnsTexture) glDeleteTextures(1, &m_Id); }
+
+	/** Returns the id of the GL texture, which is the atlas page if this texture is part of an atlas*/
 	GLuint GetId() const { return m_Id; }
 	int GetWidth() const { return m_Width; }
 	int GetHeight() const { return m_Height; }
 
+	/** Returns the position of this texture inside the GL texture*/
+	const glm::ivec2& GetPageOffset() const { return m_PageOffset; }
+
+	/** Returns the size of the GL texture*/
+	const glm::ivec2& GetPageSize() const { return m_PageSize; }
+
+	bool IsInAtlas() const { return !m_OwnsTexture; }
+
+	/** Converts a position in texels of this texture to the uv coordinates of the GL texture*/
+	glm::vec2 GetPageUV(const glm::vec2& texel) const { return (glm::vec2(m_PageOffset) + texel) / glm::vec2(m_PageSize); }
+
 	const std::filesystem::path& GetFilePath() const { return m_sourceFile; }
 
 	inline bool IsValid() { return m_Id; }
 	inline operator bool() { return IsValid(); }
 
+	/** True when the file of a texture loaded with LoadTextureAsync could not be decoded, the texture then stays invalid.*/
+	bool HasFailed() const { return m_HasFailed; }
+
 
 private:
 	GLuint m_Id{};
 	int m_Width{};
 	int m_Height{};
 
+	glm::ivec2 m_PageOffset{};
+	glm::ivec2 m_PageSize{};
+	bool m_OwnsTexture{ true };
+
+	/** Set by the loader thread*/
+	std::atomic<bool> m_HasFailed{};
+
 	std::filesystem::path m_sourceFile{};
 };
\ No newline at end of file
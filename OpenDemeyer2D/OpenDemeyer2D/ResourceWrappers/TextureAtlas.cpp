@@ -0,0 +1,121 @@
+﻿#include "pch.h"
+#include "TextureAtlas.h"
+
+#include <SDL.h>
+
+#include "ResourceWrappers/Texture2D.h"
+
+// The implementation in imgui_draw.cpp is static, so it is compiled again for the atlas
+#define STB_RECT_PACK_IMPLEMENTATION
+#define STBRP_STATIC
+#include "ImGui/imstb_rectpack.h"
+
+struct TextureAtlas::Page
+{
+	GLuint id{};
+	stbrp_context context{};
+	std::vector<stbrp_node> nodes;
+	size_t usedPixels{};
+};
+
+TextureAtlas::TextureAtlas() = default;
+
+TextureAtlas::~TextureAtlas()
+{
+	for (auto& pPage : m_Pages)
+	{
+		glDeleteTextures(1, &pPage->id);
+	}
+}
+
+std::shared_ptr<Texture2D> TextureAtlas::Find(const std::filesystem::path& file) const
+{
+	auto it = m_Regions.find(file);
+	return (it != m_Regions.end()) ? MakeView(it->second) : nullptr;
+}
+
+std::shared_ptr<Texture2D> TextureAtlas::Add(const std::filesystem::path& file, SDL_Surface* pSurface)
+{
+	if (auto texture = Find(file))
+		return texture;
+
+	const glm::ivec2 size{ pSurface->w, pSurface->h };
+	if (size.x > MaxTextureSize || size.y > MaxTextureSize)
+		return nullptr;
+
+	// Find a page with room left, or start a new one
+	Region region{ m_Pages.size(), {}, size };
+	for (size_t i{}; i < m_Pages.size(); ++i)
+	{
+		if (Pack(*m_Pages[i], region.offset, size))
+		{
+			region.page = i;
+			break;
+		}
+	}
+
+	if (region.page == m_Pages.size())
+	{
+		auto pPage = std::make_unique<Page>();
+		pPage->nodes.resize(PageSize);
+		stbrp_init_target(&pPage->context, PageSize, PageSize, pPage->nodes.data(), int(pPage->nodes.size()));
+
+		glGenTextures(1, &pPage->id);
+		glBindTexture(GL_TEXTURE_2D, pPage->id);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PageSize, PageSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		m_Pages.emplace_back(std::move(pPage));
+
+		if (!Pack(*m_Pages.back(), region.offset, size))
+			return nullptr;
+	}
+
+	// Convert to a known format so every surface can be uploaded the same way
+	SDL_Surface* pConverted{ SDL_ConvertSurfaceFormat(pSurface, SDL_PIXELFORMAT_RGBA32, 0) };
+	if (!pConverted)
+		return nullptr;
+
+	glBindTexture(GL_TEXTURE_2D, m_Pages[region.page]->id);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, pConverted->pitch / 4);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, region.offset.x, region.offset.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, pConverted->pixels);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	SDL_FreeSurface(pConverted);
+
+	m_Pages[region.page]->usedPixels += size_t(size.x) * size_t(size.y);
+	m_Regions.emplace(file, region);
+
+	return MakeView(region);
+}
+
+GLuint TextureAtlas::GetPageId(size_t page) const
+{
+	return m_Pages[page]->id;
+}
+
+float TextureAtlas::GetPageOccupancy(size_t page) const
+{
+	return float(m_Pages[page]->usedPixels) / float(PageSize * PageSize);
+}
+
+std::shared_ptr<Texture2D> TextureAtlas::MakeView(const Region& region) const
+{
+	return std::make_shared<Texture2D>(m_Pages[region.page]->id, region.size.x, region.size.y, region.offset, glm::ivec2{ PageSize, PageSize });
+}
+
+bool TextureAtlas::Pack(Page& page, glm::ivec2& offset, const glm::ivec2& size)
+{
+	stbrp_rect rect{};
+	rect.w = size.x + 2 * Padding;
+	rect.h = size.y + 2 * Padding;
+
+	if (!stbrp_pack_rects(&page.context, &rect, 1) || !rect.was_packed)
+		return false;
+
+	offset = { rect.x + Padding, rect.y + Padding };
+	return true;
+}
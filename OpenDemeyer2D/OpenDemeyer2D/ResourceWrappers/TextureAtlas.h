@@ -0,0 +1,73 @@
+﻿#pragma once
+#include <gl/glew.h>
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include "glm/glm.hpp"
+
+class Texture2D;
+struct SDL_Surface;
+
+/**
+ * Packs small textures together onto large GL textures (pages) so sprites using them can be drawn in the same batch.
+ * Packed areas are kept for the lifetime of the atlas so reloading a file reuses its area.
+ */
+class TextureAtlas final
+{
+	struct Page;
+
+	struct Region
+	{
+		size_t page{};
+		glm::ivec2 offset{};
+		glm::ivec2 size{};
+	};
+
+public:
+
+	/** Width and height of every page in pixels*/
+	static constexpr int PageSize{ 2048 };
+
+	/** Textures larger than this in either dimension get their own GL texture instead*/
+	static constexpr int MaxTextureSize{ 512 };
+
+	/** Empty pixels around every texture so neighbours do not bleed into each other*/
+	static constexpr int Padding{ 1 };
+
+	TextureAtlas();
+	~TextureAtlas();
+
+	TextureAtlas(const TextureAtlas&) = delete;
+	TextureAtlas(TextureAtlas&&) = delete;
+	TextureAtlas& operator=(const TextureAtlas&) = delete;
+	TextureAtlas& operator=(TextureAtlas&&) = delete;
+
+	/** Returns a view of the area that the file was packed into, or nullptr if the file was never added*/
+	std::shared_ptr<Texture2D> Find(const std::filesystem::path& file) const;
+
+	/**
+	 * Packs the surface onto a page and returns a texture that views the packed area.
+	 * Returns nullptr if the surface is too large to be put in the atlas.
+	 */
+	std::shared_ptr<Texture2D> Add(const std::filesystem::path& file, SDL_Surface* pSurface);
+
+	size_t GetPageAmount() const { return m_Pages.size(); }
+
+	GLuint GetPageId(size_t page) const;
+
+	/** Returns the fraction of the page that is covered by textures*/
+	float GetPageOccupancy(size_t page) const;
+
+private:
+
+	std::shared_ptr<Texture2D> MakeView(const Region& region) const;
+
+	/** Tries to pack the area on the page, returns false if there is no room left*/
+	bool Pack(Page& page, glm::ivec2& offset, const glm::ivec2& size);
+
+	std::vector<std::unique_ptr<Page>> m_Pages;
+
+	std::unordered_map<std::filesystem::path, Region> m_Regions;
+
+};
@@ -0,0 +1,181 @@
+﻿#include "pch.h"
+#include "TextureUploader.h"
+
+#include <SDL.h>
+#include <cstring>
+
+#include "ResourceWrappers/Texture2D.h"
+#include "ResourceWrappers/TextureAtlas.h"
+#include "Singletons/RenderManager.h"
+
+TextureUploader::TextureUploader(TextureAtlas& atlas)
+	: m_Atlas{ atlas }
+{
+}
+
+TextureUploader::~TextureUploader()
+{
+	Destroy();
+}
+
+void TextureUploader::Enqueue(const std::shared_ptr<Texture2D>& texture, const std::filesystem::path& file, SDL_Surface* pSurface)
+{
+	std::scoped_lock<std::mutex> lock(m_QueueLock);
+	m_Queue.emplace_back(Upload{ texture, file, pSurface });
+}
+
+void TextureUploader::Update()
+{
+	{
+		std::scoped_lock<std::mutex> lock(m_QueueLock);
+		for (auto& upload : m_Queue)
+			m_Uploads.emplace_back(std::move(upload));
+		m_Queue.clear();
+	}
+
+	size_t budget{ m_FrameBudget };
+	m_LastFrameBytes = 0;
+
+	while (!m_Uploads.empty() && budget > 0)
+	{
+		Upload& upload = m_Uploads.front();
+
+		bool isDone{};
+		if (upload.texture.expired())
+		{
+			// Nobody uses the texture anymore, there is no need to finish it
+			if (upload.id)
+				glDeleteTextures(1, &upload.id);
+			isDone = true;
+		}
+		else if (!upload.id && Begin(upload))
+		{
+			// Packed into the atlas in one go
+			const size_t size{ size_t(upload.pSurface->h) * size_t(upload.pSurface->pitch) };
+			budget -= std::min(budget, size);
+			m_LastFrameBytes += size;
+			isDone = true;
+		}
+
+		if (!isDone)
+			isDone = UploadRows(upload, budget);
+
+		if (!isDone)
+			break;
+
+		SDL_FreeSurface(upload.pSurface);
+		m_Uploads.pop_front();
+	}
+}
+
+void TextureUploader::Destroy()
+{
+	{
+		std::scoped_lock<std::mutex> lock(m_QueueLock);
+		for (auto& upload : m_Queue)
+			SDL_FreeSurface(upload.pSurface);
+		m_Queue.clear();
+	}
+
+	for (auto& upload : m_Uploads)
+	{
+		SDL_FreeSurface(upload.pSurface);
+		if (upload.id)
+			glDeleteTextures(1, &upload.id);
+	}
+	m_Uploads.clear();
+
+	if (m_Buffers[0])
+	{
+		glDeleteBuffers(GLsizei(BufferAmount), m_Buffers);
+		std::memset(m_Buffers, 0, sizeof(m_Buffers));
+		std::memset(m_BufferSizes, 0, sizeof(m_BufferSizes));
+	}
+}
+
+size_t TextureUploader::GetPendingAmount() const
+{
+	std::scoped_lock<std::mutex> lock(m_QueueLock);
+	return m_Queue.size() + m_Uploads.size();
+}
+
+bool TextureUploader::Begin(Upload& upload)
+{
+	auto texture = upload.texture.lock();
+
+	// Small textures are packed into the atlas so they can still be batched with the others
+	if (auto view = m_Atlas.Add(upload.file, upload.pSurface))
+	{
+		Fill(*texture, std::move(*view));
+		return true;
+	}
+
+	glGenTextures(1, &upload.id);
+	glBindTexture(GL_TEXTURE_2D, upload.id);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, upload.pSurface->w, upload.pSurface->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	return false;
+}
+
+bool TextureUploader::UploadRows(Upload& upload, size_t& budget)
+{
+	SDL_Surface* pSurface{ upload.pSurface };
+	const size_t pitch{ size_t(pSurface->pitch) };
+
+	const int rows{ std::min(pSurface->h - upload.uploadedRows, std::max(int(budget / pitch), 1)) };
+	const size_t size{ size_t(rows) * pitch };
+
+	if (!m_Buffers[0])
+		glGenBuffers(GLsizei(BufferAmount), m_Buffers);
+
+	const size_t buffer{ m_NextBuffer };
+	m_NextBuffer = (m_NextBuffer + 1) % BufferAmount;
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_Buffers[buffer]);
+
+	// Orphan the storage so the copy never waits for a transfer that is still reading it
+	m_BufferSizes[buffer] = std::max(m_BufferSizes[buffer], size);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, GLsizeiptr(m_BufferSizes[buffer]), nullptr, GL_STREAM_DRAW);
+
+	void* pBuffer = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, GLsizeiptr(size), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	std::memcpy(pBuffer, static_cast<const uint8_t*>(pSurface->pixels) + size_t(upload.uploadedRows) * pitch, size);
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+	// The pixels are read from the bound PBO, the transfer happens asynchronously
+	glBindTexture(GL_TEXTURE_2D, upload.id);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, int(pitch / 4));
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, upload.uploadedRows, pSurface->w, rows, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	upload.uploadedRows += rows;
+	budget -= std::min(budget, size);
+	m_LastFrameBytes += size;
+
+	if (upload.uploadedRows < pSurface->h)
+		return false;
+
+	// The texture owns the GL texture from now on
+	if (auto texture = upload.texture.lock())
+		Fill(*texture, Texture2D(upload.id, pSurface->w, pSurface->h));
+	else
+		glDeleteTextures(1, &upload.id);
+
+	upload.id = 0;
+	return true;
+}
+
+void TextureUploader::Fill(Texture2D& texture, Texture2D&& loaded)
+{
+	std::filesystem::path file{ std::move(texture.m_sourceFile) };
+	texture = std::move(loaded);
+	texture.m_sourceFile = std::move(file);
+
+	// Static layers drew the invalid texture as nothing, it is not known which of them use it
+	RENDER.InvalidateRenderLayers();
+}
@@ -0,0 +1,101 @@
+﻿#pragma once
+#include <gl/glew.h>
+#include <filesystem>
+#include <memory>
+#include <deque>
+#include <mutex>
+
+class Texture2D;
+class TextureAtlas;
+struct SDL_Surface;
+
+/**
+ * Uploads decoded surfaces to GL textures over several frames through pixel buffer objects.
+ * Loader threads hand over the surfaces, the render thread copies a budget of rows into a PBO every frame
+ * so the driver can transfer the pixels without stalling the frame.
+ * The texture that was handed out for the file stays invalid until its last row is uploaded.
+ */
+class TextureUploader final
+{
+	struct Upload
+	{
+		std::weak_ptr<Texture2D> texture;
+		std::filesystem::path file;
+		SDL_Surface* pSurface{};
+		GLuint id{};
+		int uploadedRows{};
+	};
+
+public:
+
+	/** Bytes copied to the PBOs every frame. At least one row is uploaded every frame, no matter the budget*/
+	static constexpr size_t DefaultFrameBudget{ 4 * 1024 * 1024 };
+
+	/** The PBOs are cycled so the driver can still be reading from one while the next is filled*/
+	static constexpr size_t BufferAmount{ 3 };
+
+	TextureUploader(TextureAtlas& atlas);
+	~TextureUploader();
+
+	TextureUploader(const TextureUploader&) = delete;
+	TextureUploader(TextureUploader&&) = delete;
+	TextureUploader& operator=(const TextureUploader&) = delete;
+	TextureUploader& operator=(TextureUploader&&) = delete;
+
+	/**
+	 * Queues the surface to be uploaded into the texture and takes ownership of it.
+	 * The surface has to be in the SDL_PIXELFORMAT_RGBA32 format. Can be called from any thread.
+	 */
+	void Enqueue(const std::shared_ptr<Texture2D>& texture, const std::filesystem::path& file, SDL_Surface* pSurface);
+
+	/**
+	 * Uploads rows of the queued surfaces until the frame budget is used.
+	 * Small surfaces are packed into the texture atlas instead. Call once per frame on the render thread.
+	 */
+	void Update();
+
+	/** Frees the surfaces that are still queued and the PBOs. Call before the GL context is destroyed.*/
+	void Destroy();
+
+	void SetFrameBudget(size_t bytes) { m_FrameBudget = bytes; }
+
+	size_t GetFrameBudget() const { return m_FrameBudget; }
+
+	/** Returns the amount of textures that are not completely uploaded yet.*/
+	size_t GetPendingAmount() const;
+
+	/** Returns the amount of bytes uploaded during the last update.*/
+	size_t GetLastFrameBytes() const { return m_LastFrameBytes; }
+
+private:
+
+	/** Creates the GL texture with uninitialized storage, or packs the surface into the atlas. Returns true when the upload is done.*/
+	bool Begin(Upload& upload);
+
+	/** Uploads as many rows as the budget allows. Returns true when the upload is done.*/
+	bool UploadRows(Upload& upload, size_t& budget);
+
+	/**
+	 * Makes the texture handed out to the user take over the loaded texture while keeping its file path.
+	 * Invalidates the render layers so static layers get redrawn with the loaded texture.
+	 */
+	static void Fill(Texture2D& texture, Texture2D&& loaded);
+
+private:
+
+	TextureAtlas& m_Atlas;
+
+	std::deque<Upload> m_Queue;
+	mutable std::mutex m_QueueLock;
+
+	/** Only touched by the render thread*/
+	std::deque<Upload> m_Uploads;
+
+	GLuint m_Buffers[BufferAmount]{};
+	size_t m_BufferSizes[BufferAmount]{};
+	size_t m_NextBuffer{};
+
+	size_t m_FrameBudget{ DefaultFrameBudget };
+	size_t m_LastFrameBytes{};
+
+};
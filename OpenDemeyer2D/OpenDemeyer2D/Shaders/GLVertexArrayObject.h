@@ -74,6 +74,14 @@ public:
 		glEnableVertexAttribArray(index);
 	}
 
+	/** Same as ConfigureVertexAttribute, but the attribute advances once per instance instead of once per vertex.*/
+	template <typename T>
+	void ConfigureInstanceAttribute(GLint index, size_t offset, size_t stride, bool normalized = false) const
+	{
+		ConfigureVertexAttribute<T>(index, offset, stride, normalized);
+		glVertexAttribDivisor(index, 1);
+	}
+
     void SetActive() const { glBindVertexArray(m_VertexArrayId); }
     GLuint GetBufferId() const { return m_VertexArrayId; }
 
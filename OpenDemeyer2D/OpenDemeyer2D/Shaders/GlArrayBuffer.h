@@ -122,6 +122,7 @@ public:
     {
         if (size > m_Capacity)
         {
+            glBindBuffer(GL_ARRAY_BUFFER, m_BufferId);
             glBufferData(GL_ARRAY_BUFFER, sizeof(Data) * size, data, GLenum(m_Usage));
             m_Capacity = size;
         }
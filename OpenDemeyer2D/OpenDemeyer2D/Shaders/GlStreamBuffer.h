@@ -0,0 +1,87 @@
+#pragma once
+
+#include <gl/glew.h>
+#include <algorithm>
+#include <cstring>
+
+/**
+ * Ring buffer for vertex data that is rewritten every frame.
+ * Every write goes behind the previous one, mapped unsynchronized because the GPU never reads that range yet.
+ * When a write does not fit anymore the buffer gets orphaned: the driver hands out new storage while the GPU
+ * keeps reading the old storage, so the CPU never waits for draws that are still in flight.
+ */
+template <typename Data>
+class GlStreamBuffer final
+{
+
+public:
+
+	GlStreamBuffer(size_t capacity)
+		: m_Capacity(std::max(capacity, size_t(1)))
+	{
+		glGenBuffers(1, &m_BufferId);
+
+		glBindBuffer(GL_ARRAY_BUFFER, m_BufferId);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(Data) * m_Capacity, nullptr, GL_STREAM_DRAW);
+	}
+	~GlStreamBuffer()
+	{
+		if (m_BufferId)
+			glDeleteBuffers(1, &m_BufferId);
+	}
+
+	GlStreamBuffer(const GlStreamBuffer&) = delete;
+	GlStreamBuffer(GlStreamBuffer&&) = delete;
+	GlStreamBuffer& operator=(const GlStreamBuffer&) = delete;
+	GlStreamBuffer& operator=(GlStreamBuffer&&) = delete;
+
+	/** Copies the data behind the previous write with a single memcpy and returns the index of the first written element.*/
+	size_t Write(const Data* data, size_t size)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_BufferId);
+
+		if (size > m_Capacity)
+		{
+			m_Capacity = std::max(size, m_Capacity * 2);
+			Orphan();
+		}
+		else if (m_Head + size > m_Capacity)
+		{
+			Orphan();
+		}
+
+		constexpr GLbitfield access{ GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT };
+		void* pBuffer = glMapBufferRange(GL_ARRAY_BUFFER, GLintptr(m_Head * sizeof(Data)), GLsizeiptr(size * sizeof(Data)), access);
+		std::memcpy(pBuffer, data, size * sizeof(Data));
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+
+		const size_t first{ m_Head };
+		m_Head += size;
+		return first;
+	}
+
+	GLuint GetBufferId() const { return m_BufferId; }
+	void SetActive() const { glBindBuffer(GL_ARRAY_BUFFER, m_BufferId); }
+
+	size_t GetCapacity() const { return m_Capacity; }
+
+	/** The amount of times the storage has been orphaned since the creation of the buffer.*/
+	size_t GetOrphanCount() const { return m_OrphanCount; }
+
+private:
+
+	void Orphan()
+	{
+		glBufferData(GL_ARRAY_BUFFER, sizeof(Data) * m_Capacity, nullptr, GL_STREAM_DRAW);
+		m_Head = 0;
+		++m_OrphanCount;
+	}
+
+private:
+
+	GLuint m_BufferId{};
+	size_t m_Capacity{};
+	size_t m_Head{};
+	size_t m_OrphanCount{};
+
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <gl/glew.h>
+
+/**
+ * Uniform buffer holding a single std140 block.
+ * The buffer is attached to its binding point on creation, shaders only need to bind their block to the same point.
+ */
+template <typename Data>
+class GlUniformBuffer final
+{
+
+public:
+
+	GlUniformBuffer(GLuint bindingPoint)
+		: m_BindingPoint(bindingPoint)
+	{
+		glGenBuffers(1, &m_BufferId);
+
+		glBindBuffer(GL_UNIFORM_BUFFER, m_BufferId);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(Data), nullptr, GL_DYNAMIC_DRAW);
+		glBindBufferBase(GL_UNIFORM_BUFFER, m_BindingPoint, m_BufferId);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+	~GlUniformBuffer()
+	{
+		if (m_BufferId)
+			glDeleteBuffers(1, &m_BufferId);
+	}
+
+	GlUniformBuffer(const GlUniformBuffer&) = delete;
+	GlUniformBuffer(GlUniformBuffer&&) = delete;
+	GlUniformBuffer& operator=(const GlUniformBuffer&) = delete;
+	GlUniformBuffer& operator=(GlUniformBuffer&&) = delete;
+
+	void SetData(const Data& data)
+	{
+		glBindBuffer(GL_UNIFORM_BUFFER, m_BufferId);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Data), &data);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+
+	GLuint GetBufferId() const { return m_BufferId; }
+	GLuint GetBindingPoint() const { return m_BindingPoint; }
+
+private:
+
+	GLuint m_BufferId{};
+	GLuint m_BindingPoint{};
+
+};
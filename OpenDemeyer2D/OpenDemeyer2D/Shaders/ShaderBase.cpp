@@ -48,6 +48,10 @@ ShaderBase::ShaderBase(const char* fragmentCode, const char* vertexCode, const c
 		std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
 	}
 
+	const GLuint globalsIndex{ glGetUniformBlockIndex(m_Id, "Globals") };
+	if (globalsIndex != GL_INVALID_INDEX)
+		glUniformBlockBinding(m_Id, globalsIndex, GlobalsBindingPoint);
+
 	if (fragmentShader)
 		glDeleteShader(fragmentShader);
 	if (vertexShader)
@@ -22,6 +22,9 @@ struct GLSL_GlobalVariables
 };
 static_assert(sizeof(GLSL_GlobalVariables) == 104);
 
+/** Uniform buffer binding point of the Globals block, programs declaring the block get bound to it on creation.*/
+constexpr GLuint GlobalsBindingPoint{ 0 };
+
 enum class ShaderType : GLenum
 {
 	VertexShader			= GL_VERTEX_SHADER,
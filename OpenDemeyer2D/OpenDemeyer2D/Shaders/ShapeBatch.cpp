@@ -0,0 +1,116 @@
+#include "pch.h"
+#include "ShapeBatch.h"
+
+#include "Singletons/ShaderManager.h"
+
+void ShapeBatch::AddLine(const glm::vec2& begin, const glm::vec2& end, float thickness, const glm::vec4& color)
+{
+	if (m_LineRuns.empty() || m_LineRuns.back().thickness != thickness)
+		m_LineRuns.emplace_back(LineRun{ thickness, m_Lines.size(), 0 });
+
+	m_Lines.emplace_back(ShapeVertex{ begin, color });
+	m_Lines.emplace_back(ShapeVertex{ end, color });
+	m_LineRuns.back().vertexAmount += 2;
+
+	++m_Stats.shapes;
+}
+
+void ShapeBatch::AddPolygon(const glm::vec2* points, size_t size, bool filled, const glm::vec4& color)
+{
+	if (size < 2)
+		return;
+
+	if (filled)
+	{
+		// Triangle fan around the first point
+		for (size_t i{ 1 }; i + 1 < size; ++i)
+		{
+			m_Triangles.emplace_back(ShapeVertex{ points[0], color });
+			m_Triangles.emplace_back(ShapeVertex{ points[i], color });
+			m_Triangles.emplace_back(ShapeVertex{ points[i + 1], color });
+		}
+	}
+	else
+	{
+		if (m_LineRuns.empty() || m_LineRuns.back().thickness != 1.f)
+			m_LineRuns.emplace_back(LineRun{ 1.f, m_Lines.size(), 0 });
+
+		for (size_t i{}; i < size; ++i)
+		{
+			m_Lines.emplace_back(ShapeVertex{ points[i], color });
+			m_Lines.emplace_back(ShapeVertex{ points[(i + 1) % size], color });
+		}
+		m_LineRuns.back().vertexAmount += size * 2;
+	}
+
+	++m_Stats.shapes;
+}
+
+void ShapeBatch::AddEllipse(const glm::vec2& center, const glm::vec2& radii, bool filled, const glm::vec4& color)
+{
+	m_Circles.emplace_back(center, radii, color, filled ? 0.f : 1.f);
+
+	++m_Stats.shapes;
+}
+
+void ShapeBatch::Flush()
+{
+	if (IsEmpty())
+		return;
+
+	if (!m_Triangles.empty() || !m_Lines.empty())
+	{
+		auto& shader = SHADERS.GetShader<ShapeShader>();
+
+		// The lines go behind the triangles so all vertices are written at once,
+		// a second write could orphan the buffer before the first range is drawn
+		const size_t triangleVertices{ m_Triangles.size() };
+		m_Triangles.insert(m_Triangles.end(), m_Lines.begin(), m_Lines.end());
+
+		const size_t firstTriangle{ shader.SetVertices(m_Triangles.data(), m_Triangles.size()) };
+		const size_t firstLine{ firstTriangle + triangleVertices };
+
+		shader.BeginDrawing();
+
+		if (triangleVertices)
+		{
+			shader.DrawRange(GLBufferDrawMode::Triangles, firstTriangle, triangleVertices);
+			++m_Stats.drawCalls;
+		}
+
+		for (auto& run : m_LineRuns)
+		{
+			glLineWidth(run.thickness);
+			shader.DrawRange(GLBufferDrawMode::Lines, firstLine + run.firstVertex, run.vertexAmount);
+			++m_Stats.drawCalls;
+		}
+		glLineWidth(1.f);
+
+		shader.EndDrawing();
+
+		m_Stats.vertices += m_Triangles.size();
+	}
+
+	if (!m_Circles.empty())
+	{
+		auto& shader = SHADERS.GetShader<CircleShader>();
+		shader.SetCircles(m_Circles);
+		shader.Draw();
+
+		++m_Stats.drawCalls;
+		m_Stats.circles += m_Circles.size();
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	m_Triangles.clear();
+	m_Lines.clear();
+	m_LineRuns.clear();
+	m_Circles.clear();
+}
+
+void ShapeBatch::EndFrame()
+{
+	m_LastFrameStats = m_Stats;
+	m_Stats = {};
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "ShapesShaders.h"
+
+struct ShapeBatchStats final
+{
+	size_t shapes{};
+	size_t drawCalls{};
+	size_t vertices{};
+	size_t circles{};
+};
+
+/**
+ * Collects debug shapes during the frame and draws them in a few draw calls on a flush.
+ * Filled polygons become triangles, outlines become lines and circles and ellipses go through the CircleShader.
+ * The shapes are drawn per kind: first the triangles, then the lines and then the circles.
+ */
+class ShapeBatch final
+{
+public:
+
+	ShapeBatch() = default;
+	~ShapeBatch() = default;
+
+	ShapeBatch(const ShapeBatch&) = delete;
+	ShapeBatch(ShapeBatch&&) = delete;
+	ShapeBatch& operator=(const ShapeBatch&) = delete;
+	ShapeBatch& operator=(ShapeBatch&&) = delete;
+
+	void AddLine(const glm::vec2& begin, const glm::vec2& end, float thickness, const glm::vec4& color);
+
+	/** Filled polygons are expected to be convex, like the polygons of Box2D.*/
+	void AddPolygon(const glm::vec2* points, size_t size, bool filled, const glm::vec4& color);
+
+	void AddEllipse(const glm::vec2& center, const glm::vec2& radii, bool filled, const glm::vec4& color);
+
+	bool IsEmpty() const { return m_Triangles.empty() && m_Lines.empty() && m_Circles.empty(); }
+
+	/** Draws and clears all queued shapes to the bound render target.*/
+	void Flush();
+
+	/** Stores the statistics of the frame that just ended and starts counting a new frame.*/
+	void EndFrame();
+
+	const ShapeBatchStats& GetStats() const { return m_LastFrameStats; }
+
+private:
+
+	// Consecutive lines with the same thickness are drawn together
+	struct LineRun final
+	{
+		float thickness{};
+		size_t firstVertex{};
+		size_t vertexAmount{};
+	};
+
+	std::vector<ShapeVertex> m_Triangles;
+	std::vector<ShapeVertex> m_Lines;
+	std::vector<LineRun> m_LineRuns;
+	std::vector<CircleShader::CircleData> m_Circles;
+
+	ShapeBatchStats m_Stats{};
+	ShapeBatchStats m_LastFrameStats{};
+
+};
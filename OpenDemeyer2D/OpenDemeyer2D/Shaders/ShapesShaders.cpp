@@ -1,17 +1,15 @@
 #include "pch.h"
 #include "ShapesShaders.h"
 
-CircleShader::CircleData::CircleData(const glm::mat3& _transform, const glm::vec4& _color)
-	: transform(_transform)
+CircleShader::CircleData::CircleData(const glm::vec2& _center, const glm::vec2& _radii, const glm::vec4& _color, float _lineWidth)
+	: center(_center)
+	, radii(_radii)
 	, color(_color)
+	, lineWidth(_lineWidth)
 {}
 
 CircleShader::CircleData::CircleData(const glm::vec2& position, float radius, const glm::vec4& color)
-	: transform(
-		radius,	0,		position.x,
-		0,		radius,	position.y,
-		0,		0,		1)
-	, color(color)
+	: CircleData(position, { radius, radius }, color)
 {}
 
 void CircleShader::SetCircles(const std::vector<CircleData>& circleData)
@@ -21,18 +19,22 @@ void CircleShader::SetCircles(const std::vector<CircleData>& circleData)
 
 void CircleShader::SetCircles(const CircleData* circleData, size_t size)
 {
-	m_Buffer.SetData(circleData, size);
+	m_FirstCircle = m_Buffer.Write(circleData, size);
+	m_CircleAmount = size;
 }
 
 void CircleShader::SetCircle(const CircleData& circleData)
 {
-	m_Buffer.SetData(&circleData, 1);
+	SetCircles(&circleData, 1);
 }
 
 void CircleShader::Draw() const
 {
 	SetActive();
-	m_Buffer.DrawArray(GLBufferDrawMode::Points);
+	m_VertexAttr.SetActive();
+	glDrawArrays(GL_POINTS, GLint(m_FirstCircle), GLsizei(m_CircleAmount));
+	glBindVertexArray(0);
+	glUseProgram(0);
 }
 
 CircleShader::CircleShader()
@@ -41,9 +43,53 @@ CircleShader::CircleShader()
 		std::filesystem::path("../Resources/Shaders/SimpleSquare.vs"), 
 		std::filesystem::path("../Resources/Shaders/SimpleSquare.gs"))
 {
-	m_VertexAttr.ConfigureVertexAttribute<glm::vec3>(0, 0, sizeof(CircleData));
-	m_VertexAttr.ConfigureVertexAttribute<glm::vec3>(1, 12, sizeof(CircleData));
-	m_VertexAttr.ConfigureVertexAttribute<glm::vec3>(2, 24, sizeof(CircleData));
-	m_VertexAttr.ConfigureVertexAttribute<glm::vec4>(3, offsetof(CircleData, CircleData::color), sizeof(CircleData));
+	m_Buffer.SetActive();
+	m_VertexAttr.ConfigureVertexAttribute<glm::vec4>(0, offsetof(CircleData, center), sizeof(CircleData));
+	m_VertexAttr.ConfigureVertexAttribute<glm::vec4>(1, offsetof(CircleData, color), sizeof(CircleData));
+	m_VertexAttr.ConfigureVertexAttribute<float>(2, offsetof(CircleData, lineWidth), sizeof(CircleData));
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+size_t ShapeShader::SetVertices(const ShapeVertex* vertices, size_t size)
+{
+	m_FirstVertex = m_Buffer.Write(vertices, size);
+	m_VertexAmount = size;
+	return m_FirstVertex;
+}
+
+void ShapeShader::BeginDrawing() const
+{
+	SetActive();
+	m_VertexAttr.SetActive();
+}
+
+void ShapeShader::EndDrawing() const
+{
+	glBindVertexArray(0);
+	glUseProgram(0);
+}
+
+void ShapeShader::DrawRange(GLBufferDrawMode mode, size_t firstVertex, size_t vertexAmount) const
+{
+	glDrawArrays(GLenum(mode), GLint(firstVertex), GLsizei(vertexAmount));
+}
+
+void ShapeShader::Draw() const
+{
+	BeginDrawing();
+	DrawRange(GLBufferDrawMode::Triangles, m_FirstVertex, m_VertexAmount);
+	EndDrawing();
+}
+
+ShapeShader::ShapeShader()
+	: ShaderBase(
+		std::filesystem::path("../Resources/Shaders/Shape.fs"),
+		std::filesystem::path("../Resources/Shaders/Shape.vs"))
+{
+	m_Buffer.SetActive();
+	m_VertexAttr.ConfigureVertexAttribute<glm::vec2>(0, offsetof(ShapeVertex, position), sizeof(ShapeVertex));
+	m_VertexAttr.ConfigureVertexAttribute<glm::vec4>(1, offsetof(ShapeVertex, color), sizeof(ShapeVertex));
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
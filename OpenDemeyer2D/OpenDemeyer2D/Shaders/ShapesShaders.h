@@ -3,8 +3,13 @@
 #include "ShaderBase.h"
 #include <glm/glm.hpp>
 #include "GlArrayBuffer.h"
+#include "GlStreamBuffer.h"
 #include "GLVertexArrayObject.h"
 
+/**
+ * Draws circles and ellipses, one point per circle that the geometry shader expands to a square.
+ * The fragment shader cuts the circle out of the square, so no vertices are spent on the curve.
+ */
 class CircleShader final : protected ShaderBase
 {
 	friend class ShaderManager;
@@ -12,12 +17,15 @@ class CircleShader final : protected ShaderBase
 public:
 	struct CircleData final
 	{
-		glm::mat3 transform;
+		glm::vec2 center;
+		glm::vec2 radii;
 		glm::vec4 color;
+		// Width of the outline in pixels, 0 draws a filled circle
+		float lineWidth;
 
 		CircleData() = default;
 		~CircleData() = default;
-		CircleData(const glm::mat3& transform, const glm::vec4& color);
+		CircleData(const glm::vec2& center, const glm::vec2& radii, const glm::vec4& color, float lineWidth = 0.f);
 		CircleData(const glm::vec2& position, float radius, const glm::vec4& color);
 		CircleData(const CircleData&) = default;
 		CircleData(CircleData&&) noexcept = default;
@@ -30,6 +38,7 @@ public:
 	void SetCircles(const CircleData* circleData, size_t size);
 	void SetCircle(const CircleData& circleData);
 
+	/** Draws the circles that have been set last.*/
 	void Draw() const override;
 
 private:
@@ -38,9 +47,50 @@ private:
 
 private:
 
-	GlArrayBuffer<CircleData> m_Buffer{ 1, GLBufferUsage::DynamicDraw };
+	GlStreamBuffer<CircleData> m_Buffer{ 256 };
 	GLVertexArrayObject m_VertexAttr{};
 
+	size_t m_FirstCircle{};
+	size_t m_CircleAmount{};
+
+};
+
+struct ShapeVertex final
+{
+	glm::vec2 position;
+	glm::vec4 color;
 };
 
+/** Draws untextured colored vertices, used for lines and polygons.*/
+class ShapeShader final : protected ShaderBase
+{
+	friend class ShaderManager;
+
+public:
+
+	/** Copies the vertices to the stream buffer and returns the index of the first vertex.*/
+	size_t SetVertices(const ShapeVertex* vertices, size_t size);
+
+	/** Activates the program and the vertex layout. Call EndDrawing when done.*/
+	void BeginDrawing() const;
+	void EndDrawing() const;
+
+	/** Draws a range of the vertices that have been set, the shader has to be active.*/
+	void DrawRange(GLBufferDrawMode mode, size_t firstVertex, size_t vertexAmount) const;
 
+	/** Draws the vertices that have been set last as triangles.*/
+	void Draw() const override;
+
+private:
+
+	ShapeShader();
+
+private:
+
+	GlStreamBuffer<ShapeVertex> m_Buffer{ 1024 };
+	GLVertexArrayObject m_VertexAttr{};
+
+	size_t m_FirstVertex{};
+	size_t m_VertexAmount{};
+
+};
@@ -0,0 +1,129 @@
+#include "pch.h"
+#include "SpriteBatch.h"
+
+#include <algorithm>
+
+#include "Singletons/ShaderManager.h"
+
+SpriteBatch::SpriteBatch(size_t targetAmount)
+	: m_TargetAmount{ targetAmount }
+{
+	assert(targetAmount <= 256);
+}
+
+uint32_t SpriteBatch::MakeSortKey(size_t target, int depth)
+{
+	constexpr int depthBias{ 1 << 23 };
+	const uint32_t biasedDepth{ uint32_t(std::clamp(depth, -depthBias, depthBias - 1) + depthBias) };
+
+	return (uint32_t(target) << 24) | biasedDepth;
+}
+
+void SpriteBatch::AddSprite(size_t target, int depth, GLuint texture, const SpriteInstance& instance)
+{
+	assert(target < m_TargetAmount);
+
+	m_Commands.emplace_back(Command{ MakeSortKey(target, depth), uint32_t(m_Instances.size()), texture });
+	m_Instances.emplace_back(instance);
+
+	++m_Stats.sprites;
+}
+
+void SpriteBatch::Flush(const std::function<void(size_t)>& bindTarget)
+{
+	if (m_Commands.empty())
+		return;
+
+	SortCommands();
+
+	// Write the instances in sorted order and start a new batch every time the target or the texture changes
+	for (auto& command : m_Commands)
+	{
+		const size_t target{ size_t(command.key >> 24) };
+
+		if (m_Batches.empty() || m_Batches.back().target != target || m_Batches.back().texture != command.texture)
+			m_Batches.emplace_back(Batch{ target, command.texture, m_SortedInstances.size(), 0 });
+
+		m_SortedInstances.emplace_back(m_Instances[command.instance]);
+		++m_Batches.back().instanceAmount;
+	}
+
+	auto& shader = SHADERS.GetShader<SpriteShader>();
+
+	const size_t orphanCount{ shader.GetOrphanCount() };
+	const size_t firstInstance{ shader.SetInstances(m_SortedInstances.data(), m_SortedInstances.size()) };
+	m_Stats.bufferOrphans += shader.GetOrphanCount() - orphanCount;
+
+	shader.BeginDrawing();
+
+	size_t boundTarget{ m_TargetAmount };
+	for (auto& batch : m_Batches)
+	{
+		if (batch.target != boundTarget)
+		{
+			bindTarget(batch.target);
+			boundTarget = batch.target;
+			++m_Stats.targetBinds;
+		}
+
+		shader.DrawRange(batch.texture, firstInstance + batch.firstInstance, batch.instanceAmount);
+	}
+
+	shader.EndDrawing();
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	m_Stats.drawCalls += m_Batches.size();
+	m_Stats.instanceBytes += m_SortedInstances.size() * sizeof(SpriteInstance);
+	++m_Stats.flushes;
+
+	m_Commands.clear();
+	m_Instances.clear();
+	m_SortedInstances.clear();
+	m_Batches.clear();
+}
+
+void SpriteBatch::EndFrame()
+{
+	m_LastFrameStats = m_Stats;
+	m_Stats = {};
+}
+
+void SpriteBatch::SortCommands()
+{
+	constexpr size_t digits{ sizeof(uint32_t) };
+	const size_t size{ m_Commands.size() };
+
+	// Count every digit in one pass
+	uint32_t histograms[digits][256]{};
+	for (auto& command : m_Commands)
+	{
+		for (size_t digit{}; digit < digits; ++digit)
+			++histograms[digit][(command.key >> (digit * 8)) & 0xFF];
+	}
+
+	m_SortBuffer.resize(size);
+
+	// Least significant digit first, every pass is stable so the result is sorted on the whole key
+	for (size_t digit{}; digit < digits; ++digit)
+	{
+		auto& histogram = histograms[digit];
+
+		// All keys share this digit, the pass would not move anything
+		const uint32_t firstValue{ uint32_t((m_Commands.front().key >> (digit * 8)) & 0xFF) };
+		if (histogram[firstValue] == size)
+			continue;
+
+		uint32_t offset{};
+		for (auto& count : histogram)
+		{
+			const uint32_t amount{ count };
+			count = offset;
+			offset += amount;
+		}
+
+		for (auto& command : m_Commands)
+			m_SortBuffer[histogram[(command.key >> (digit * 8)) & 0xFF]++] = command;
+
+		m_Commands.swap(m_SortBuffer);
+	}
+}
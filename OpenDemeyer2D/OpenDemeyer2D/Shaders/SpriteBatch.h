@@ -0,0 +1,95 @@
+﻿#pragma once
+
+#include <vector>
+#include <functional>
+#include <gl/glew.h>
+#include <glm/glm.hpp>
+
+#include "SpriteShader.h"
+
+struct SpriteBatchStats final
+{
+	size_t sprites{};
+	size_t drawCalls{};
+	size_t instanceBytes{};
+	size_t flushes{};
+	size_t targetBinds{};
+	size_t bufferOrphans{};
+};
+
+/**
+ * Render queue for sprites. Every sprite is submitted with a 32 bit sort key that packs its render target
+ * and its depth. On a flush the keys are radix sorted so every target gets bound once.
+ * The radix sort is stable, sprites sharing a target and a depth keep their submission order so they still overlap
+ * in scene order. Consecutive sprites in the sorted order that share a texture are drawn with one glDrawArraysInstanced call.
+ * All instances of a flush are copied to the stream buffer of the SpriteShader at once.
+ */
+class SpriteBatch final
+{
+public:
+
+	SpriteBatch(size_t targetAmount);
+	~SpriteBatch() = default;
+
+	SpriteBatch(const SpriteBatch&) = delete;
+	SpriteBatch(SpriteBatch&&) = delete;
+	SpriteBatch& operator=(const SpriteBatch&) = delete;
+	SpriteBatch& operator=(SpriteBatch&&) = delete;
+
+	/**
+	 * Packs the target in the highest 8 bits and the depth in the lowest 24 bits.
+	 * Lower depths are drawn first. The depth is clamped to a signed 24 bit range.
+	 */
+	static uint32_t MakeSortKey(size_t target, int depth);
+
+	/** Adds a sprite to the queue.*/
+	void AddSprite(size_t target, int depth, GLuint texture, const SpriteInstance& instance);
+
+	bool IsEmpty() const { return m_Commands.empty(); }
+
+	/**
+	 * Sorts, draws and clears all queued sprites.
+	 * bindTarget is called once for every target that has sprites, before the sprites of that target are drawn.
+	 */
+	void Flush(const std::function<void(size_t)>& bindTarget);
+
+	/** Stores the statistics of the frame that just ended and starts counting a new frame.*/
+	void EndFrame();
+
+	const SpriteBatchStats& GetStats() const { return m_LastFrameStats; }
+
+private:
+
+	struct Command final
+	{
+		uint32_t key{};
+		uint32_t instance{};
+		GLuint texture{};
+	};
+
+	struct Batch final
+	{
+		size_t target{};
+		GLuint texture{};
+		size_t firstInstance{};
+		size_t instanceAmount{};
+	};
+
+	void SortCommands();
+
+	size_t m_TargetAmount{};
+
+	std::vector<Command> m_Commands;
+	std::vector<Command> m_SortBuffer;
+
+	// Instances in submission order
+	std::vector<SpriteInstance> m_Instances;
+
+	// The instances in sorted order and the batches drawing them
+	std::vector<SpriteInstance> m_SortedInstances;
+	std::vector<Batch> m_Batches;
+
+	SpriteBatchStats m_Stats{};
+	SpriteBatchStats m_LastFrameStats{};
+
+};
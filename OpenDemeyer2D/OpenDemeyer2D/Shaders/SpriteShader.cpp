@@ -0,0 +1,66 @@
+#include "pch.h"
+#include "SpriteShader.h"
+
+size_t SpriteShader::SetInstances(const SpriteInstance* instances, size_t size)
+{
+	m_FirstInstance = m_Buffer.Write(instances, size);
+	m_InstanceAmount = size;
+	return m_FirstInstance;
+}
+
+void SpriteShader::BeginDrawing() const
+{
+	SetActive();
+	m_VertexAttr.SetActive();
+	m_Buffer.SetActive();
+	glActiveTexture(GL_TEXTURE0);
+}
+
+void SpriteShader::EndDrawing() const
+{
+	glBindVertexArray(0);
+	glUseProgram(0);
+}
+
+void SpriteShader::DrawRange(GLuint texture, size_t firstInstance, size_t instanceAmount) const
+{
+	SetFirstInstance(firstInstance);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, GLsizei(instanceAmount));
+}
+
+void SpriteShader::Draw() const
+{
+	// Uses the texture that is currently bound
+	BeginDrawing();
+	SetFirstInstance(m_FirstInstance);
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, GLsizei(m_InstanceAmount));
+	EndDrawing();
+}
+
+SpriteShader::SpriteShader()
+	: ShaderBase(
+		std::filesystem::path("../Resources/Shaders/Sprite.fs"),
+		std::filesystem::path("../Resources/Shaders/Sprite.vs"))
+{
+	m_Buffer.SetActive();
+	SetFirstInstance(0);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	SetActive();
+	SetInt("sprite", 0);
+	glUseProgram(0);
+}
+
+void SpriteShader::SetFirstInstance(size_t firstInstance) const
+{
+	constexpr size_t stride{ sizeof(SpriteInstance) };
+	const size_t offset{ firstInstance * stride };
+
+	m_VertexAttr.ConfigureInstanceAttribute<glm::vec4>(0, offset + offsetof(SpriteInstance, transform.a), stride);
+	m_VertexAttr.ConfigureInstanceAttribute<glm::vec2>(1, offset + offsetof(SpriteInstance, transform.x), stride);
+	m_VertexAttr.ConfigureInstanceAttribute<glm::vec2>(2, offset + offsetof(SpriteInstance, pivot), stride);
+	m_VertexAttr.ConfigureInstanceAttribute<glm::vec4>(3, offset + offsetof(SpriteInstance, sourceRect), stride);
+	m_VertexAttr.ConfigureInstanceAttribute<glm::vec4>(4, offset + offsetof(SpriteInstance, tint), stride);
+}
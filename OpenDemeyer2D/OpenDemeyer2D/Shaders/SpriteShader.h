@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ShaderBase.h"
+#include <glm/glm.hpp>
+#include "GlStreamBuffer.h"
+#include "GLVertexArrayObject.h"
+#include "UtilityFiles/Affine2D.h"
+
+/** Per instance data of a sprite. The 4 corners of the quad are generated in the vertex shader.*/
+struct SpriteInstance final
+{
+	// Rotation, scale and the size of the source rectangle in a b c d, world position in x y
+	Affine2D transform;
+	glm::vec2 pivot;
+	// Left, top, right and bottom of the source rectangle in texture coordinates
+	glm::vec4 sourceRect;
+	glm::vec4 tint;
+};
+
+/**
+ * Draws sprites as instanced quads, all sprites sharing a texture are drawn with one glDrawArraysInstanced call.
+ * The positions are transformed by the view matrix of the Globals block.
+ * The instances of a frame are streamed through a ring buffer, see GlStreamBuffer.
+ */
+class SpriteShader final : protected ShaderBase
+{
+	friend class ShaderManager;
+
+public:
+
+	/** Copies the instances to the stream buffer and returns the index of the first instance.*/
+	size_t SetInstances(const SpriteInstance* instances, size_t size);
+
+	/** Activates the program and the vertex layout. Call EndDrawing when done to go back to the fixed function pipeline.*/
+	void BeginDrawing() const;
+	void EndDrawing() const;
+
+	/** Draws a range of the instances that have been set, the shader has to be active.*/
+	void DrawRange(GLuint texture, size_t firstInstance, size_t instanceAmount) const;
+
+	void Draw() const override;
+
+	size_t GetOrphanCount() const { return m_Buffer.GetOrphanCount(); }
+
+private:
+
+	SpriteShader();
+
+	// Without base instance support (GL 4.2) the attributes are pointed at the first instance of every draw
+	void SetFirstInstance(size_t firstInstance) const;
+
+private:
+
+	GlStreamBuffer<SpriteInstance> m_Buffer{ 1024 };
+	GLVertexArrayObject m_VertexAttr{};
+
+	size_t m_FirstInstance{};
+	size_t m_InstanceAmount{};
+
+};
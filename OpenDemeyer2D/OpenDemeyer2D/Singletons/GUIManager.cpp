@@ -20,10 +20,13 @@
 #include "Singletons/ResourceManager.h"
 #include "Singletons/SceneManager.h"
 #include "Singletons/RenderManager.h"
+#include "Shaders/SpriteBatch.h"
+#include "Shaders/ShapeBatch.h"
 #include "Singletons/InputManager.h"
 
 #include "ResourceWrappers/RenderTarget.h"
 #include "ResourceWrappers/Prefab.h"
+#include "ResourceWrappers/Font.h"
 
 #include "EngineFiles/GameObject.h"
 #include "EngineFiles/ComponentBase.h"
@@ -32,9 +35,11 @@
 #include "Components/RenderComponent.h"
 #include "Components/PhysicsComponent.h"
 #include "Components/Transform.h"
+#include "Components/SpriteComponent.h"
 
 #include "Allocators/NewDeleteOverride.h"
 #include "Allocators/SmallObjectAllocator.h"
+#include "Allocators/AllocatorBenchmark.h"
 
 void GUIManager::Init(SDL_Window* window)
 {
@@ -168,6 +173,15 @@ void GUIManager::RenderImGuiRenderInfo()
 		text += std::to_string(i);
 		ImGui::Text(text.c_str());
 
+		bool isStatic{ RENDER.IsRenderLayerStatic(int(i)) };
+		if (ImGui::Checkbox(("Static##" + std::to_string(i)).c_str(), &isStatic))
+			RENDER.SetRenderLayerStatic(int(i), isStatic);
+		if (isStatic)
+		{
+			ImGui::SameLine();
+			ImGui::Text(RENDER.IsRenderLayerRedrawn(int(i)) ? "(redrawn)" : "(cached)");
+		}
+
 		float aspectRatio = float(renderLayers[i]->GetWidth()) / float(renderLayers[i]->GetHeight());
 
 #pragma warning(disable : 4312)
@@ -659,6 +673,183 @@ void GUIManager::RenderImGuiFileDetails()
 	ImGui::End();
 }
 
+/**
+ * Lays out a counter that changes every iteration, like a score, and returns how long it took in milliseconds.
+ * Uses its own cache of the font so the statistics of the cache in use are not changed.
+ */
+static float BenchmarkTextLayout(_TTF_Font* pFont, int iterations)
+{
+	GlyphCache glyphCache{ pFont };
+
+	FrameVector<RenderQuad> quads{};
+	quads.reserve(32);
+
+	char buffer[32]{};
+
+	// Rasterize the glyphs before timing, the cache in use already has them
+	glyphCache.Layout("SCORE 0123456789", quads);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i{}; i < iterations; ++i)
+	{
+		quads.clear();
+		const int length{ snprintf(buffer, sizeof(buffer), "SCORE %d", i * 37) };
+		glyphCache.Layout({ buffer, size_t(length) }, quads);
+	}
+	return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/** Returns the duration of copying the prefab and of instantiating its template, both in milliseconds*/
+static std::pair<float, float> BenchmarkPrefab(const Prefab& prefab, int iterations)
+{
+	float copyDuration{};
+	{
+		Scene scene("Prefab Benchmark");
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int i{}; i < iterations; ++i)
+			prefab.InstantiateCopy(&scene);
+		copyDuration = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	float templateDuration{};
+	{
+		Scene scene("Prefab Benchmark");
+		std::vector<GameObject*> instances{};
+		auto start = std::chrono::high_resolution_clock::now();
+		prefab.Instantiate(&scene, size_t(iterations), instances);
+		templateDuration = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	return { copyDuration, templateDuration };
+}
+
+/**
+ * Rotates the root of a single chain of transforms every frame and propagates it down the chain,
+ * once through a TransformStore and once with 3x3 matrices that are decomposed again, how the transforms were updated before.
+ * Returns both durations in milliseconds
+ */
+static std::pair<float, float> BenchmarkTransformChain(int depth, int frames)
+{
+	constexpr glm::vec2 localPosition{ 1.f, 0.f };
+	constexpr glm::vec2 localScale{ 1.f, 1.f };
+	constexpr float localRotation{ 1.f };
+
+	float storeDuration{};
+	{
+		TransformStore store{};
+		std::vector<uint32_t> handles(size_t(depth), TransformStore::InvalidHandle);
+		for (size_t i{}; i < handles.size(); ++i)
+		{
+			handles[i] = store.Create();
+			if (i) store.SetParent(handles[i], handles[i - 1]);
+			store.SetLocal(handles[i], localPosition, localScale, localRotation);
+			store.SetDirty(handles[i]);
+		}
+		store.Update();
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int frame{}; frame < frames; ++frame)
+		{
+			store.SetLocal(handles.front(), localPosition, localScale, float(frame));
+			for (uint32_t handle : handles)
+				store.SetDirty(handle);
+			store.Update();
+		}
+		storeDuration = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	float matrixDuration{};
+	{
+		auto toMatrix = [](const glm::vec2& position, const glm::vec2& scale, float rotation)
+		{
+			const float radians{ glm::radians(rotation) };
+			const float sinAngle{ sinf(radians) }, cosAngle{ cosf(radians) };
+			return glm::mat3x3{
+				scale.x * cosAngle, scale.y * sinAngle, 0.f,
+				-scale.x * sinAngle, scale.y * cosAngle, 0.f,
+				position.x, position.y, 1.f };
+		};
+
+		std::vector<glm::mat3x3> localMatrices(size_t(depth), toMatrix(localPosition, localScale, localRotation));
+		std::vector<glm::mat3x3> worldMatrices(static_cast<size_t>(depth));
+		std::vector<glm::vec2> worldPositions(static_cast<size_t>(depth)), worldScales(static_cast<size_t>(depth));
+		std::vector<float> worldRotations(static_cast<size_t>(depth));
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int frame{}; frame < frames; ++frame)
+		{
+			localMatrices.front() = toMatrix(localPosition, localScale, float(frame));
+			worldMatrices.front() = localMatrices.front();
+			for (size_t i{}; i < worldMatrices.size(); ++i)
+			{
+				if (i) worldMatrices[i] = worldMatrices[i - 1] * localMatrices[i];
+
+				const glm::mat3x3& matrix = worldMatrices[i];
+				worldPositions[i] = { matrix[2][0], matrix[2][1] };
+				worldScales[i] = {
+					glm::sign(matrix[0][0]) * glm::sqrt(matrix[0][0] * matrix[0][0] + matrix[1][0] * matrix[1][0]),
+					glm::sign(matrix[1][1]) * glm::sqrt(matrix[0][1] * matrix[0][1] + matrix[1][1] * matrix[1][1]) };
+				worldRotations[i] = glm::degrees(atan2f(matrix[1][0], matrix[1][1]));
+			}
+		}
+		matrixDuration = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	return { storeDuration, matrixDuration };
+}
+
+std::pair<float, float> GUIManager::BenchmarkComponentUpdate(int objectAmount, int frames)
+{
+	constexpr int childAmount{ 9 };
+	constexpr float deltaTime{ 1.f / 60.f };
+
+	Scene scene("Component Update Benchmark");
+	scene.ReserveGameObjects(size_t(objectAmount), size_t(objectAmount / (childAmount + 1)));
+
+	for (int i{}; i < objectAmount; i += childAmount + 1)
+	{
+		GameObject* pRoot = scene.CreateGameObject();
+		pRoot->AddComponent<SpriteComponent>();
+		for (int j{}; j < childAmount && i + j + 1 < objectAmount; ++j)
+			scene.CreateGameObject(pRoot)->AddComponent<SpriteComponent>();
+	}
+
+	// Initializes and begins play of every object
+	scene.PreUpdate(true);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i{}; i < frames; ++i)
+		scene.Update(deltaTime);
+	const float poolDuration{ std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() };
+
+	// Calls every component of every object like the scene did before the component pools
+	std::vector<GameObject*> stack{};
+	auto walkTree = [&scene, &stack](auto&& call)
+	{
+		stack.assign(scene.GetSceneTree().begin(), scene.GetSceneTree().end());
+		while (!stack.empty())
+		{
+			GameObject* pObject = stack.back();
+			stack.pop_back();
+
+			for (auto& [id, pComponent] : pObject->GetComponents())
+				call(pComponent);
+			for (GameObject* pChild : pObject->GetChildren())
+				stack.emplace_back(pChild);
+		}
+	};
+
+	start = std::chrono::high_resolution_clock::now();
+	for (int i{}; i < frames; ++i)
+	{
+		walkTree([deltaTime](ComponentBase* pComponent) { pComponent->Update(deltaTime); });
+		walkTree([](ComponentBase* pComponent) { pComponent->LateUpdate(); });
+	}
+	const float treeWalkDuration{ std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() };
+
+	return { poolDuration, treeWalkDuration };
+}
+
 void GUIManager::RenderImGuiEngineStats()
 {
 	ImGui::Begin("Statistics");
@@ -669,18 +860,195 @@ void GUIManager::RenderImGuiEngineStats()
 	ImGui::Text("Application average %.3f ms/frame", 1000.f / ImGui::GetIO().Framerate);
 	ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
 	ImGui::Text("Resolution: %.3i x %.1i", w, h);
+
+	auto& spriteStats = RENDER.GetSpriteBatchStats();
+	ImGui::Text("Sprites: %zd", spriteStats.sprites);
+	ImGui::Text("Draw calls: %zd, Instance data: %zd bytes, Flushes: %zd", spriteStats.drawCalls, spriteStats.instanceBytes, spriteStats.flushes);
+	ImGui::Text("Render target binds: %zd, Stream buffer orphans: %zd", spriteStats.targetBinds, spriteStats.bufferOrphans);
+
+	auto& shapeStats = RENDER.GetShapeBatchStats();
+	ImGui::Text("Debug shapes: %zd, Draw calls: %zd, Vertices: %zd, Circles: %zd", shapeStats.shapes, shapeStats.drawCalls, shapeStats.vertices, shapeStats.circles);
+
+	auto& transformStore = SCENES.GetActiveScene()->GetTransformStore();
+	ImGui::Text("Transforms: %zd, Depth: %zd, Update: %.3f ms", transformStore.GetSize(), transformStore.GetDepth(), transformStore.GetLastUpdateDuration());
+	{
+		constexpr int benchmarkDepth{ 10000 };
+		constexpr int benchmarkFrames{ 10 };
+		static std::pair<float, float> benchmarkDurations{};
+
+		ImGui::SameLine();
+		if (ImGui::Button("Benchmark##TransformStore"))
+			benchmarkDurations = BenchmarkTransformChain(benchmarkDepth, benchmarkFrames);
+
+		if (benchmarkDurations.first > 0.f)
+			ImGui::Text("Chain of %d transforms, %d frames: %.3f ms in the store, %.3f ms with decomposed matrices", benchmarkDepth, benchmarkFrames, benchmarkDurations.first, benchmarkDurations.second);
+	}
+
+	auto& boundsTree = SCENES.GetActiveScene()->GetRenderBoundsTree();
+	ImGui::Text("Render components: %zd, Visible: %zd, Moved bounds: %zd", boundsTree.GetSize(), boundsTree.GetVisibleAmount(), boundsTree.GetMovedAmount());
+
+	ImGui::Text("Component Pools");
+
+	ImGui::BeginChild("ComponentPools", ImVec2(0, 120), true);
+	for (auto& pPool : SCENES.GetActiveScene()->GetComponentRegistry().GetPools())
+	{
+		auto typeInfo = TypeInformation::GetInstance().GetTypeInfo(pPool->GetTypeId());
+		std::string_view name{ typeInfo ? typeInfo->name : std::string_view{ "Unknown" } };
+		auto& hooks = pPool->GetHooks();
+		ImGui::Text("%.*s: %zd %s%s%s", int(name.size()), name.data(), pPool->GetSize(),
+			hooks.update ? "[Update]" : "", hooks.lateUpdate ? "[LateUpdate]" : "", hooks.beginPlay ? "[BeginPlay]" : "");
+	}
+	ImGui::EndChild();
+
+	{
+		constexpr int benchmarkObjects{ 100000 };
+		constexpr int benchmarkFrames{ 10 };
+		static std::pair<float, float> benchmarkDurations{};
+
+		if (ImGui::Button("Benchmark##ComponentPools"))
+			benchmarkDurations = BenchmarkComponentUpdate(benchmarkObjects, benchmarkFrames);
+
+		if (benchmarkDurations.first > 0.f)
+		{
+			ImGui::SameLine();
+			ImGui::Text("%d objects, %d frames: %.3f ms per pool, %.3f ms walking the tree", benchmarkObjects, benchmarkFrames, benchmarkDurations.first, benchmarkDurations.second);
+		}
+	}
+
+	ImGui::Text("Texture Atlas");
+	{
+		auto& atlas = RESOURCES.GetTextureAtlas();
+		for (size_t i{}; i < atlas.GetPageAmount(); ++i)
+		{
+			char buff[32]{};
+			sprintf(buff, "Page %zd: %.1f%%", i, atlas.GetPageOccupancy(i) * 100.f);
+			ImGui::ProgressBar(atlas.GetPageOccupancy(i), ImVec2(), buff);
+		}
+
+		auto& uploader = RESOURCES.GetTextureUploader();
+		ImGui::Text("Pending texture uploads: %zd, Uploaded: %zd bytes", uploader.GetPendingAmount(), uploader.GetLastFrameBytes());
+	}
+
+	ImGui::Text("Glyph Caches");
+	{
+		constexpr int benchmarkIterations{ 10000 };
+		static float benchmarkDuration{};
+
+		for (auto& [key, weakFont] : RESOURCES.GetLoadedFonts())
+		{
+			auto font = weakFont.lock();
+			if (!font || !font->TryGetGlyphCache())
+				continue;
+
+			auto& glyphCache = font->GetGlyphCache();
+			const std::string name{ key.first.filename().string() + ' ' + std::to_string(key.second) };
+
+			ImGui::Text("%s: %zd glyphs, %zd layouts, %zd characters", name.c_str(), glyphCache.GetGlyphAmount(), glyphCache.GetLayoutCount(), glyphCache.GetCharacterCount());
+			ImGui::SameLine();
+			if (ImGui::Button(("Benchmark##" + name).c_str()))
+				benchmarkDuration = BenchmarkTextLayout(font->GetFont(), benchmarkIterations);
+		}
+
+		if (benchmarkDuration > 0.f)
+			ImGui::Text("%d changing strings laid out in %.3f ms", benchmarkIterations, benchmarkDuration);
+	}
+
+	ImGui::Text("Prefab Templates");
+	{
+		constexpr int benchmarkIterations{ 1000 };
+		static std::pair<float, float> benchmarkDurations{};
+
+		for (auto& [file, weakPrefab] : RESOURCES.GetPrefabs())
+		{
+			auto prefab = weakPrefab.lock();
+			if (!prefab || !prefab->GetTemplate().IsCompiled())
+				continue;
+
+			auto& prefabTemplate = prefab->GetTemplate();
+			const std::string name{ file.filename().string() };
+
+			ImGui::Text("%s: %zd objects, %zd components, %zd patches, %zd bytes", name.c_str(), prefabTemplate.GetNodeAmount(),
+				prefabTemplate.GetComponentAmount(), prefabTemplate.GetPatchAmount(), prefabTemplate.GetImageSize());
+			ImGui::SameLine();
+			if (ImGui::Button(("Benchmark##" + name).c_str()))
+				benchmarkDurations = BenchmarkPrefab(*prefab, benchmarkIterations);
+		}
+
+		if (benchmarkDurations.first > 0.f)
+			ImGui::Text("%d instances: %.3f ms copied, %.3f ms from the template", benchmarkIterations, benchmarkDurations.first, benchmarkDurations.second);
+	}
+
+	ImGui::Text("Scene Loading");
+	{
+		const float loadTime{ RESOURCES.GetLastSceneLoadTime() };
+		if (loadTime > 0.f)
+			ImGui::Text("Last scene loaded from %s file in %.3f ms", RESOURCES.WasLastSceneLoadBinary() ? "binary" : "text", loadTime);
+
+		if (SCENES.GetLastPlaySceneTime() > 0.f)
+			ImGui::Text("Last scene started playing in %.3f ms", SCENES.GetLastPlaySceneTime());
+
+		if (auto pScene = SCENES.GetActiveScene())
+		{
+			for (auto& streamer : pScene->GetStreamers())
+			{
+				char buff[64]{};
+				snprintf(buff, sizeof(buff), "%zd objects", streamer->GetLoadedObjectAmount());
+				ImGui::ProgressBar(streamer->GetProgress(), ImVec2(), buff);
+				ImGui::SameLine();
+				ImGui::Text("%s", streamer->GetFile().filename().string().c_str());
+			}
+		}
+	}
+
+	ImGui::Text("ObjectPoolAllocator");
+	{
+		constexpr int benchmarkObjects{ 100000 };
+		constexpr int benchmarkChurn{ 10000 };
+		static std::pair<float, float> benchmarkDurations{};
+
+		if (ImGui::Button("Benchmark##ObjectPoolAllocator"))
+			benchmarkDurations = BenchmarkObjectPoolAllocator(benchmarkObjects, benchmarkChurn);
+
+		if (benchmarkDurations.first > 0.f)
+		{
+			ImGui::SameLine();
+			ImGui::Text("%d objects, %d reallocations: %.3f ms, %.3f ms scanning", benchmarkObjects, benchmarkChurn, benchmarkDurations.first, benchmarkDurations.second);
+		}
+	}
+
 	ImGui::Text("SmallObjectAllocator");
+	{
+		constexpr int benchmarkObjects{ 100000 };
+		constexpr int benchmarkChurn{ 10000 };
+		static std::pair<float, float> benchmarkDurations{};
+
+		if (ImGui::Button("Benchmark##SmallObjectAllocator"))
+			benchmarkDurations = BenchmarkSmallObjectAllocator(benchmarkObjects, benchmarkChurn);
+
+		if (benchmarkDurations.first > 0.f)
+		{
+			ImGui::SameLine();
+			ImGui::Text("%d objects, %d reallocations: %.3f ms, %.3f ms scanning", benchmarkObjects, benchmarkChurn, benchmarkDurations.first, benchmarkDurations.second);
+		}
+	}
 
 	ImGui::BeginChild("SmallObjectAllocator", ImVec2(0, 200), true);
 	auto& alloc = GetSmallObjectAllocator();
-	for (auto& pools : alloc.GetPools())
 	{
-		ImGui::Text("%zd", pools.front().GetElementSize());
-		for (auto& pool : pools)
+		std::lock_guard poolLock{ alloc.GetPoolMutex() };
+		for (auto& pools : alloc.GetPools())
 		{
-			char buff[32]{};
-			sprintf(buff, "%zd/%zd", pool.GetCurrentElementAmount(), pool.GetMaxElementAmount());
-			ImGui::ProgressBar(float(pool.GetCurrentElementAmount()) / float(pool.GetMaxElementAmount()), ImVec2(), buff);
+			// Pools are only created once their size is requested
+			if (pools.empty())
+				continue;
+
+			ImGui::Text("%zd", pools.front()->GetElementSize());
+			for (auto pPool : pools)
+			{
+				char buff[32]{};
+				sprintf(buff, "%zd/%zd", pPool->GetCurrentElementAmount(), pPool->GetMaxElementAmount());
+				ImGui::ProgressBar(float(pPool->GetCurrentElementAmount()) / float(pPool->GetMaxElementAmount()), ImVec2(), buff);
+			}
 		}
 	}
 	ImGui::EndChild();
@@ -709,6 +1077,7 @@ void GUIManager::RenderImGuiEngineStats()
 		char buff[32]{};
 		sprintf(buff, "%zd/%zd", StackAllocator.GetStackHeight(), StackAllocator.GetStackSize());
 		ImGui::ProgressBar(float(StackAllocator.GetStackHeight()) / float(StackAllocator.GetStackSize()), ImVec2(), buff);
+		ImGui::Text("High water mark: %zd bytes, Overflows: %zd", StackAllocator.GetHighWaterMark(), StackAllocator.GetOverflowCount());
 		if (StackAllocator.GetStacks().size())
 		{
 			ImGui::BeginChild("stackAllocator");
@@ -1216,7 +1585,7 @@ GameObject* SearchObjectForHit(const glm::vec2& point, GameObject* ob)
 	return nullptr;
 }
 
-void SearchObjectForHit(const glm::vec2& point, GameObject* ob, std::vector<GameObject*>& hits)
+void SearchObjectForHit(const glm::vec2& point, GameObject* ob, FrameVector<GameObject*>& hits)
 {
 	glm::vec2 vertices[4]{};
 	if (ob->GetRenderComponent() && IsPointInRect(point, ob->GetRenderComponent()->GetWorldRect(vertices)))
@@ -1278,21 +1647,25 @@ GameObject* ObjectParentTreeNode(GameObject* ob)
 	return nullptr;
 }
 
-void RemoveParentsFromVector(std::vector<GameObject*>& vector)
+void RemoveParentsFromVector(FrameVector<GameObject*>& vector)
 {
-	ODArray copy{ vector };
+	FrameVector<GameObject*> copy{ vector };
 
 	for (auto ob : vector)
 	{
 		GameObject* pCurrent{ ob->GetParent() };
 		while (pCurrent)
 		{
-			copy.SwapRemove(pCurrent);
+			if (auto it = std::find(copy.begin(), copy.end(), pCurrent); it != copy.end())
+			{
+				*it = copy.back();
+				copy.pop_back();
+			}
 			pCurrent = pCurrent->GetParent();
 		}
 	}
 
-	vector = copy;
+	vector = std::move(copy);
 }
 
 void GUIManager::FullScreenDockSpace()
@@ -1365,9 +1738,10 @@ void GUIManager::RenderImGuiGameWindow()
 	auto& renderer = RENDER;
 
 	renderer.SetRenderTarget(m_ImGuiRenderTarget);
-	for (auto& renderTarget : renderer.GetRenderLayers())
+	auto& renderLayers = renderer.GetRenderLayers();
+	for (size_t i{}; i < renderLayers.size(); ++i)
 	{
-		renderer.RenderTexture(renderTarget, glm::vec2{ 0,renderTarget->GetHeight() }, { 1,-1 }, 0, { 1,1 });
+		renderer.RenderTexture(renderLayers[i], glm::vec2{ 0,renderLayers[i]->GetHeight() }, { 1,-1 }, 0, { 1,1 }, nullptr, -1, int(i));
 	}
 	renderer.SetRenderTargetScreen();
 
@@ -1388,6 +1762,7 @@ void GUIManager::RenderImGuiGameWindow()
 		mousePos.x *= m_GameResWidth / imageSize.x;
 		mousePos.y *= m_GameResHeight / imageSize.y;
 		mousePos.y = m_GameResHeight - mousePos.y;
+		mousePos += RENDER.GetCameraPosition();
 
 		auto& sceneTree = SCENES.GetActiveScene()->GetSceneTree();
 		for (GameObject* pObject : sceneTree)
@@ -1409,15 +1784,19 @@ void GUIManager::RenderImGuiGameWindow()
 		mousePos.x *= m_GameResWidth / imageSize.x;
 		mousePos.y *= m_GameResHeight / imageSize.y;
 		mousePos.y = m_GameResHeight - mousePos.y;
+		mousePos += RENDER.GetCameraPosition();
 
 		auto& sceneTree = SCENES.GetActiveScene()->GetSceneTree();
-		m_HitObjects.clear();
+		FrameVector<GameObject*> hits{};
 		for (GameObject* pObject : sceneTree)
 		{
-			SearchObjectForHit(mousePos, pObject, m_HitObjects);
-			RemoveParentsFromVector(m_HitObjects);
+			SearchObjectForHit(mousePos, pObject, hits);
+			RemoveParentsFromVector(hits);
 		}
 
+		// The popup stays open over multiple frames so the result has to leave the frame stack
+		m_HitObjects.assign(hits.begin(), hits.end());
+
 		if (!m_HitObjects.empty())
 		{
 			ImGui::OpenPopup("hit objects");
@@ -63,6 +63,9 @@ private:
 	
 	void RenderImGuiEngineStats();
 	void RenderImGuiEngineSettings();
+
+	/** Returns the duration of updating the components per pool and by walking the scene tree, both in milliseconds*/
+	static std::pair<float, float> BenchmarkComponentUpdate(int objectAmount, int frames);
 	
 	void RenderImGuiGameObjectRecursive(GameObject* go);
 	
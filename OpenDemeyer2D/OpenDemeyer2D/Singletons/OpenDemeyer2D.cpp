@@ -73,9 +73,9 @@ void Engine::Initialize()
 		throw std::runtime_error(std::string("SDL_Init Error: ") + SDL_GetError());
 	}
 
-	// Use OpenGL 3.0
+	// Use OpenGL 3.3, the shaders use GLSL 330
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
-	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 1);
+	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
 
 	SDL_DisplayMode DM;
 	SDL_GetCurrentDisplayMode(0, &DM);
@@ -170,12 +170,16 @@ void Engine::Run()
 
 	{
 		auto& renderer = RENDER;
+		auto& resources = RESOURCES;
 		auto& sceneManager = SCENES;
 		auto& input = INPUT;
+		auto& frameAllocator = GetStackAllocator();
 		
 		auto lastTime = high_resolution_clock::now();
 		while (!m_Quit)
 		{
+			// Everything allocated on the frame stack during the previous frame is released here
+			frameAllocator.Reset();
 
 			const auto currentTime = high_resolution_clock::now();
 			float deltaTime = duration<float>(currentTime - lastTime).count();
@@ -195,6 +199,9 @@ void Engine::Run()
 
 			sceneManager.AfterUpdate();
 
+			// Spread the texture uploads of asynchronous loads over the frames
+			resources.UploadTextures();
+
 			renderer.Render();
 
 
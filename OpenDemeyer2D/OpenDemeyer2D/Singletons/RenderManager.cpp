@@ -14,6 +14,9 @@
 #include "Singletons/GUIManager.h"
 #include "Singletons/ShaderManager.h"
 #include "Shaders/ShapesShaders.h"
+#include "Shaders/SpriteBatch.h"
+#include "Shaders/ShapeBatch.h"
+#include "Shaders/GlUniformBuffer.h"
 
 int GetOpenGLDriverIndex()
 {
@@ -72,21 +75,20 @@ void RenderManager::Init(SDL_Window* window)
 
 	SDL_GL_GetDrawableSize(window, &m_WindowResWidth, &m_WindowResHeight);
 
-	// Set the Projection matrix to the identity matrix
-	glMatrixMode(GL_PROJECTION);
-	glLoadIdentity();
+	// Sprites and debug shapes get the projection through the Globals block
+	m_ProjectionMatrix = glm::mat3{
+		2.f / float(m_GameResWidth), 0.f, 0.f,
+		0.f, 2.f / float(m_GameResHeight), 0.f,
+		-1.f, -1.f, 1.f };
 
-	// Set up a two-dimensional orthographic viewing region.
-	gluOrtho2D(0, m_GameResWidth, 0, m_GameResHeight); // y from bottom to top
+	m_pGlobals = std::make_unique<GLSL_GlobalVariables>();
+	m_pGlobalsBuffer = std::make_unique<GlUniformBuffer<GLSL_GlobalVariables>>(GlobalsBindingPoint);
+	UpdateGlobals();
 
 	// Set the viewport to the client window area
 	// The viewport is the rectangular region of the window where the image is drawn.
 	glViewport(0, 0, m_GameResWidth, m_GameResHeight);
 
-	// Set the Modelview matrix to the identity matrix
-	glMatrixMode(GL_MODELVIEW);
-	glLoadIdentity();
-
 	// Enable color blending and use alpha blending
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -98,18 +100,47 @@ void RenderManager::Init(SDL_Window* window)
 	{
 		m_RenderLayers.emplace_back(RESOURCES.CreateRenderTexture(m_GameResWidth, m_GameResHeight));
 	}
+	m_RenderLayerStates.resize(m_RenderLayers.size());
+
+	m_pSpriteBatch = std::make_unique<SpriteBatch>(m_RenderLayers.size() + 1);
+	m_pShapeBatch = std::make_unique<ShapeBatch>();
 }
 
+RenderManager::RenderManager() = default;
+
+RenderManager::~RenderManager() = default;
+
 void RenderManager::Render()
 {
+	m_pSpriteBatch->EndFrame();
+	m_pShapeBatch->EndFrame();
+
+	const float time{ float(SDL_GetTicks()) / 1000.f };
+	m_pGlobals->deltaTime = time - m_pGlobals->time;
+	m_pGlobals->time = time;
+	UpdateGlobals();
 
 	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT);
 
-	for (auto& renderTarget : m_RenderLayers)
+	for (size_t i{}; i < m_RenderLayers.size(); ++i)
 	{
+		auto& state = m_RenderLayerStates[i];
+		state.isRedrawn = !state.isStatic || state.isInvalidated;
+		state.isInvalidated = false;
+
+#ifdef _DEBUG
+		// The editor draws its hitboxes and selection outlines on the last layer every frame
+		if (i + 1 == m_RenderLayers.size())
+			state.isRedrawn = true;
+#endif
+
+		// Static layers that did not change keep what was drawn on them
+		if (!state.isRedrawn)
+			continue;
+
 		glClearColor(0, 0, 0, 0);
-		glBindFramebuffer(GL_FRAMEBUFFER, renderTarget->GetFrameBuffer());
+		glBindFramebuffer(GL_FRAMEBUFFER, m_RenderLayers[i]->GetFrameBuffer());
 		glClear(GL_COLOR_BUFFER_BIT);
 	}
 
@@ -119,27 +150,33 @@ void RenderManager::Render()
 #endif
 
 	SetRenderTarget(m_RenderLayers[0]); {
-	glPushMatrix();
-		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT);
-		glScalef(1, -1, 1);
-		glTranslatef(0, -static_cast<float>(m_GameResHeight), 0);
+		if (m_RenderLayerStates[0].isRedrawn)
+		{
+			glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT);
+		}
+
+		// Move the world by the camera and flip the y axis so y goes from top to bottom in the game
+		SetViewMatrix(glm::mat3{ 1.f, 0.f, 0.f, 0.f, -1.f, 0.f, -m_CameraPosition.x, float(m_GameResHeight) + m_CameraPosition.y, 1.f });
 
 		SCENES.Render();
+		FlushSprites();
 
 #ifdef _DEBUG
 		gui.RenderGUIOnGame();
 #endif
 
-	glPopMatrix();
+		SetViewMatrix(glm::mat3{ 1.f });
 	} SetRenderTargetScreen();
 
 #ifdef _DEBUG // Draw to GUI ViewPort
 	gui.RenderGUI();
 	gui.EndGUI();
 #else // Draw to screen
-	for (auto& target : m_RenderLayers)
-		RenderTexture(target, glm::vec2{ 0,0 }, { 1,1 }, 0, { 1,1 });
+	// The layer index is used as depth so the layers are composited in order
+	for (size_t i{}; i < m_RenderLayers.size(); ++i)
+		RenderTexture(m_RenderLayers[i], glm::vec2{ 0,0 }, { 1,1 }, 0, { 1,1 }, nullptr, -1, int(i));
+	FlushSprites();
 #endif
 
 	for (auto& call : m_PostDrawGLCalls)
@@ -151,171 +188,234 @@ void RenderManager::Render()
 
 void RenderManager::Destroy()
 {
+	m_pSpriteBatch.reset();
+	m_pShapeBatch.reset();
+	m_pGlobalsBuffer.reset();
 	SDL_GL_DeleteContext(m_pContext);
 }
 
 void RenderManager::RenderTexture(const std::shared_ptr<Texture2D>& texture, const glm::vec2& pos,
-	const glm::vec2& scale, float rotation, const glm::vec2& pivot, const SDL_FRect* srcRect, int renderTarget) const
+	const glm::vec2& scale, float rotation, const glm::vec2& pivot, const SDL_FRect* srcRect, int renderTarget, int depth, const SDL_Color& tint) const
 {
-	RenderTexture(texture->GetId(), texture->GetWidth(), texture->GetHeight(), pos, scale, rotation, pivot, srcRect, renderTarget);
+	// Textures loaded asynchronously are not drawn until their upload finished
+	if (!texture->IsValid())
+		return;
+
+	// The source rectangle is in the space of the texture, move it to where the texture is on its GL texture
+	SDL_FRect pageRect{ srcRect ? *srcRect : SDL_FRect{ 0.f, 0.f, float(texture->GetWidth()), float(texture->GetHeight()) } };
+	pageRect.x += float(texture->GetPageOffset().x);
+	pageRect.y += float(texture->GetPageOffset().y);
+
+	RenderTexture(texture->GetId(), texture->GetPageSize().x, texture->GetPageSize().y, pos, scale, rotation, pivot, &pageRect, renderTarget, depth, tint);
 }
 
 void RenderManager::RenderTexture(const std::shared_ptr<RenderTarget>& texture, const glm::vec2& pos,
-	const glm::vec2& scale, float rotation, const glm::vec2& pivot, const SDL_FRect* srcRect, int renderTarget) const
+	const glm::vec2& scale, float rotation, const glm::vec2& pivot, const SDL_FRect* srcRect, int renderTarget, int depth, const SDL_Color& tint) const
 {
-	RenderTexture(texture->GetRenderedTexture(), texture->GetWidth(), texture->GetHeight(), pos, scale, rotation, pivot, srcRect, renderTarget);
+	RenderTexture(texture->GetRenderedTexture(), texture->GetWidth(), texture->GetHeight(), pos, scale, rotation, pivot, srcRect, renderTarget, depth, tint);
 }
 
 
 
+void RenderManager::SetRenderLayerStatic(int layer, bool isStatic)
+{
+	auto& state = m_RenderLayerStates[layer];
+	if (state.isStatic != isStatic)
+	{
+		state.isStatic = isStatic;
+		state.isInvalidated = true;
+	}
+}
+
+void RenderManager::InvalidateRenderLayer(int layer)
+{
+	if (layer >= 0 && size_t(layer) < m_RenderLayerStates.size())
+		m_RenderLayerStates[layer].isInvalidated = true;
+}
+
+void RenderManager::InvalidateRenderLayers()
+{
+	for (auto& state : m_RenderLayerStates)
+		state.isInvalidated = true;
+}
+
 void RenderManager::SetRenderTarget(const std::shared_ptr<RenderTarget>& renderTarget) const
 {
-	glBindFramebuffer(GL_FRAMEBUFFER, renderTarget->GetFrameBuffer());
-	glViewport(0, 0, renderTarget->GetWidth(), renderTarget->GetHeight());
+	FlushSprites();
+	BindRenderTarget(renderTarget);
 }
 
 void RenderManager::SetRenderTargetScreen() const
 {
+	FlushSprites();
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 	glViewport(0, 0, m_WindowResWidth, m_WindowResHeight);
 }
 
-void RenderManager::AddGLCallAfterDrawing(const std::function<void()>& call)
+void RenderManager::SetViewMatrix(const glm::mat3& view)
 {
-	m_PostDrawGLCalls.emplace_back(call);
+	FlushSprites();
+	m_ViewMatrix = view;
+	UpdateGlobals();
 }
 
-void RenderManager::RenderTexture(GLuint glId, int w, int h, const glm::vec2& pos, const glm::vec2& scale, float rotation,
-	const glm::vec2& pivot, const SDL_FRect* srcRect, int renderTarget) const
+void RenderManager::SetCameraPosition(const glm::vec2& position)
 {
-	if (renderTarget != -1) {
-		assert(int(m_RenderLayers.size()) > renderTarget && renderTarget >= 0);
-		SetRenderTarget(m_RenderLayers[renderTarget]);
-	}
+	if (m_CameraPosition == position)
+		return;
+
+	m_CameraPosition = position;
+	InvalidateRenderLayers();
+}
+
+void RenderManager::FlushSprites() const
+{
+	if (m_pSpriteBatch->IsEmpty() && m_pShapeBatch->IsEmpty())
+		return;
+
+	GLint frameBuffer{};
+	GLint viewport[4]{};
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &frameBuffer);
+	glGetIntegerv(GL_VIEWPORT, viewport);
+
+	// Sprites without a render layer belong to the target that is bound right now
+	bool hasBoundLayer{};
+	m_pSpriteBatch->Flush([this, &hasBoundLayer](size_t target)
+		{
+			if (target != 0)
+			{
+				BindRenderTarget(m_RenderLayers[target - 1]);
+				hasBoundLayer = true;
+			}
+		});
 
+	// Go back to the target that was bound, the debug shapes are drawn on top of it
+	if (hasBoundLayer)
 	{
-		float width = (srcRect) ? srcRect->w : static_cast<float>(w);
-		float height = (srcRect) ? srcRect->h : static_cast<float>(h);
+		glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
+		glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+	}
 
-		glm::vec2 vertices[4]{};
+	m_pShapeBatch->Flush();
+}
 
-		// Vertex coordinates for centered orientation
-		float vertexLeft{ pivot.x - 1.f };
-		float vertexBottom{ pivot.y - 1.f };
-		float vertexRight{ pivot.x };
-		float vertexTop{ pivot.y };
+const SpriteBatchStats& RenderManager::GetSpriteBatchStats() const
+{
+	return m_pSpriteBatch->GetStats();
+}
 
-		vertexLeft *= width * scale.x;
-		vertexRight *= width * scale.x;
-		vertexTop *= height * scale.y;
-		vertexBottom *= height * scale.y;
+const ShapeBatchStats& RenderManager::GetShapeBatchStats() const
+{
+	return m_pShapeBatch->GetStats();
+}
 
-		constexpr float inverse180{ 1.f / 180.f * float(M_PI) };
+void RenderManager::BindRenderTarget(const std::shared_ptr<RenderTarget>& renderTarget) const
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, renderTarget->GetFrameBuffer());
+	glViewport(0, 0, renderTarget->GetWidth(), renderTarget->GetHeight());
+}
 
-		float cosAngle = cos(rotation * inverse180);
-		float sinAngle = sin(rotation * inverse180);
+void RenderManager::UpdateGlobals()
+{
+	const glm::mat3 view{ m_ProjectionMatrix * m_ViewMatrix };
+	m_pGlobals->view = glm::mat3x4{ view };
+	m_pGlobals->invView = glm::mat3x4{ glm::inverse(view) };
+	m_pGlobalsBuffer->SetData(*m_pGlobals);
+}
 
-		vertices[0] = { vertexLeft * cosAngle - vertexBottom * sinAngle, vertexBottom * cosAngle + vertexLeft * sinAngle };
-		vertices[1] = { vertexLeft * cosAngle - vertexTop * sinAngle, vertexTop * cosAngle + vertexLeft * sinAngle };
-		vertices[2] = { vertexRight * cosAngle - vertexTop * sinAngle, vertexTop * cosAngle + vertexRight * sinAngle };
-		vertices[3] = { vertexRight * cosAngle - vertexBottom * sinAngle, vertexBottom * cosAngle + vertexRight * sinAngle };
+void RenderManager::AddGLCallAfterDrawing(const std::function<void()>& call)
+{
+	m_PostDrawGLCalls.emplace_back(call);
+}
 
-		vertices[0] += pos;
-		vertices[1] += pos;
-		vertices[2] += pos;
-		vertices[3] += pos;
+void RenderManager::RenderTexture(GLuint glId, int w, int h, const glm::vec2& pos, const glm::vec2& scale, float rotation,
+	const glm::vec2& pivot, const SDL_FRect* srcRect, int renderTarget, int depth, const SDL_Color& tint) const
+{
+	assert(renderTarget == -1 || (int(m_RenderLayers.size()) > renderTarget && renderTarget >= 0));
 
-		// Texture coordinates
-		float textLeft{ 0 };
-		float textRight{ 1 };
-		float textBottom{ 1 };
-		float textTop{ 0 };
+	if (renderTarget != -1 && !m_RenderLayerStates[renderTarget].isRedrawn)
+		return;
 
-		if (srcRect)
-		{
-			textLeft = srcRect->x / w;
-			textRight = (srcRect->x + srcRect->w) / w;
-			textTop = (srcRect->y) / h;
-			textBottom = (srcRect->y + srcRect->h) / h;
-		}
+	float width = (srcRect) ? srcRect->w : static_cast<float>(w);
+	float height = (srcRect) ? srcRect->h : static_cast<float>(h);
 
+	constexpr float inverse180{ 1.f / 180.f * float(M_PI) };
 
-		// Tell opengl which texture we will use
-		glBindTexture(GL_TEXTURE_2D, glId);
-		glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+	float cosAngle = cos(rotation * inverse180);
+	float sinAngle = sin(rotation * inverse180);
 
-		// Draw
-		glEnable(GL_TEXTURE_2D);
-		{
-			glBegin(GL_QUADS);
-			{
-				glTexCoord2f(textLeft, textBottom);
-				glVertex2f(vertices[0].x, vertices[0].y);
+	SpriteInstance instance{};
 
-				glTexCoord2f(textLeft, textTop);
-				glVertex2f(vertices[1].x, vertices[1].y);
+	// Scale the unit quad to the source rectangle and the scale of the object, then rotate it
+	instance.transform = Affine2D{
+		cosAngle * scale.x * width, -sinAngle * scale.y * height,
+		sinAngle * scale.x * width, cosAngle * scale.y * height,
+		pos.x, pos.y };
 
-				glTexCoord2f(textRight, textTop);
-				glVertex2f(vertices[2].x, vertices[2].y);
+	instance.pivot = pivot;
 
-				glTexCoord2f(textRight, textBottom);
-				glVertex2f(vertices[3].x, vertices[3].y);
-			}
-			glEnd();
-		}
-		glDisable(GL_TEXTURE_2D);
+	// Texture coordinates
+	instance.sourceRect = { 0.f, 0.f, 1.f, 1.f };
+	if (srcRect)
+	{
+		instance.sourceRect = {
+			srcRect->x / w,
+			srcRect->y / h,
+			(srcRect->x + srcRect->w) / w,
+			(srcRect->y + srcRect->h) / h };
 	}
 
+	instance.tint = glm::vec4{ tint.r, tint.g, tint.b, tint.a } / 255.f;
 
-	//SetRenderTargetScreen();
+	// Queue the sprite, it gets sorted by target and depth and drawn together with the neighbouring sprites using this texture in FlushSprites
+	m_pSpriteBatch->AddSprite(size_t(renderTarget + 1), depth, glId, instance);
 }
 
 /**
  * STATIC FUNCTIONS
  */
 
+static glm::vec4 ToVec4(const SDL_Color& color)
+{
+	return glm::vec4{ color.r, color.g, color.b, color.a } / 255.f;
+}
+
 void RenderManager::SetColor(const SDL_Color& color)
 {
-	glColor4ub(color.r, color.g, color.b, color.a);
+	GetInstance().m_ShapeColor = color;
 }
 
 void RenderManager::RenderPoint(const glm::vec2& pos, float pointSize, SDL_Color* pColor)
 {
 	if (pColor) SetColor(*pColor);
 
-	glPointSize(pointSize);
-	glBegin(GL_POINTS);
-	glVertex2f(pos.x, pos.y);
-	glEnd();
+	auto& renderer = GetInstance();
+	renderer.m_pShapeBatch->AddEllipse(pos, { pointSize * 0.5f, pointSize * 0.5f }, true, ToVec4(renderer.m_ShapeColor));
 }
 
 void RenderManager::RenderLine(const glm::vec2& begin, const glm::vec2& end, float thickness, SDL_Color* pColor)
 {
 	if (pColor) SetColor(*pColor);
 
-	glLineWidth(thickness);
-	glBegin(GL_LINES);
-	glVertex2f(begin.x, begin.y);
-	glVertex2f(end.x, end.y);
-	glEnd();
+	auto& renderer = GetInstance();
+	renderer.m_pShapeBatch->AddLine(begin, end, thickness, ToVec4(renderer.m_ShapeColor));
 }
 
 void RenderManager::RenderRect(const SDL_FRect& rect, bool filled, SDL_Color* pColor)
 {
-	if (pColor) SetColor(*pColor);
+	const glm::vec2 points[4]
+	{
+		{ rect.x, rect.y },
+		{ rect.x + rect.w, rect.y },
+		{ rect.x + rect.w, rect.y + rect.h },
+		{ rect.x, rect.y + rect.h }
+	};
 
-	glBegin(filled ? GL_POLYGON : GL_LINE_LOOP);
-	glVertex2f(rect.x, rect.y);
-	glVertex2f(rect.x + rect.w, rect.y);
-	glVertex2f(rect.x + rect.w, rect.y + rect.h);
-	glVertex2f(rect.x, rect.y + rect.h);
-	glEnd();
+	RenderPolygon(points, 4, filled, pColor);
 }
 
 void RenderManager::RenderPolygon(const std::vector<glm::vec2>& points, bool filled, SDL_Color* pColor)
 {
-	if (pColor) SetColor(*pColor);
-
 	RenderPolygon(points.data(), points.size(), filled, pColor);
 }
 
@@ -323,36 +423,19 @@ void RenderManager::RenderPolygon(const glm::vec2* points, size_t size, bool fil
 {
 	if (pColor) SetColor(*pColor);
 
-	glBegin(filled ? GL_POLYGON : GL_LINE_LOOP);
-	for (size_t i{}; i < size; ++i)
-	{
-		glVertex2f(points[i].x, points[i].y);
-	}
-	glEnd();
+	auto& renderer = GetInstance();
+	renderer.m_pShapeBatch->AddPolygon(points, size, filled, ToVec4(renderer.m_ShapeColor));
 }
 
-// SOURCE: Digital Arts and Entertainment programming 2 framework
 void RenderManager::RenderEllipse(const glm::vec2& center, const glm::vec2& radii, bool filled, SDL_Color* pColor)
 {
 	if (pColor) SetColor(*pColor);
 
-	float dAngle{ radii.x > radii.y ? float(M_PI / radii.x) : float(M_PI / radii.y) };
-
-	glBegin(filled ? GL_POLYGON : GL_LINE_LOOP);
-	{
-		for (float angle = 0.0; angle < float(2 * M_PI); angle += dAngle)
-		{
-			glVertex2f(center.x + radii.x * float(cos(angle)), center.y + radii.y * float(sin(angle)));
-		}
-	}
-	glEnd();
+	auto& renderer = GetInstance();
+	renderer.m_pShapeBatch->AddEllipse(center, radii, filled, ToVec4(renderer.m_ShapeColor));
 }
 
-void RenderManager::RenderCircle(const glm::vec2& /*pos*/, float /*radius*/, const glm::vec4& /*color*/)
+void RenderManager::RenderCircle(const glm::vec2& pos, float radius, const glm::vec4& color)
 {
-	//auto& circleShader = SHADERS.GetShader<CircleShader>();
-	//
-	//circleShader.SetCircle(CircleShader::CircleData(pos, radius, color));
-	//circleShader.Draw();
+	m_pShapeBatch->AddEllipse(pos, { radius, radius }, true, color);
 }
-
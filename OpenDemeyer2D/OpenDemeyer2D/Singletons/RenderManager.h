@@ -13,6 +13,13 @@
 #define RENDER RenderManager::GetInstance()
 
 class ComponentBase;
+class SpriteBatch;
+struct SpriteBatchStats;
+class ShapeBatch;
+struct ShapeBatchStats;
+struct GLSL_GlobalVariables;
+template <typename Data>
+class GlUniformBuffer;
 
 enum class eRenderAlignMode : Uint8
 {
@@ -27,6 +34,15 @@ enum class eRenderAlignMode : Uint8
 	centered = 8
 };
 
+/** A part of a texture that is drawn at an offset inside the source rectangle of a render component*/
+struct RenderQuad
+{
+	SDL_FRect sourceRect;
+
+	/** Offset in pixels from the corner of the source rectangle where the local coordinates are smallest*/
+	glm::vec2 offset;
+};
+
 class RenderManager final : public Singleton<RenderManager>
 {
 
@@ -38,28 +54,91 @@ public:
 	void Render();
 	void Destroy();
 
-	void RenderTexture(const std::shared_ptr<Texture2D>& texture, const glm::vec2& pos = {0.f,0.f}, const glm::vec2& scale = { 1.f,1.f }, float rotation = 0, const glm::vec2& pivot = { 0.5f,0.5f }, const SDL_FRect* srcRect = nullptr, int renderLayer = -1) const;
+	/**
+	 * Queues a textured quad. Quads are sorted on render layer, then depth before they are drawn.
+	 * Quads on the same layer with the same depth are drawn in the order they were queued.
+	 * The texture color is multiplied with the tint.
+	 */
+	void RenderTexture(const std::shared_ptr<Texture2D>& texture, const glm::vec2& pos = {0.f,0.f}, const glm::vec2& scale = { 1.f,1.f }, float rotation = 0, const glm::vec2& pivot = { 0.5f,0.5f }, const SDL_FRect* srcRect = nullptr, int renderLayer = -1, int depth = 0, const SDL_Color& tint = { 255,255,255,255 }) const;
 
-	void RenderTexture(const std::shared_ptr<RenderTarget>& texture, const glm::vec2& pos = { 0.f,0.f }, const glm::vec2& scale = { 1.f,1.f }, float rotation = 0, const glm::vec2& pivot = { 0.5f,0.5f }, const SDL_FRect* srcRect = nullptr, int renderLayer = -1) const;
+	void RenderTexture(const std::shared_ptr<RenderTarget>& texture, const glm::vec2& pos = { 0.f,0.f }, const glm::vec2& scale = { 1.f,1.f }, float rotation = 0, const glm::vec2& pivot = { 0.5f,0.5f }, const SDL_FRect* srcRect = nullptr, int renderLayer = -1, int depth = 0, const SDL_Color& tint = { 255,255,255,255 }) const;
 
 	void SetRenderTarget(const std::shared_ptr<RenderTarget>& renderTarget) const;
 
 	void SetRenderTargetScreen() const;
 
+	/**
+	 * Sets the transformation from world space to game resolution pixels used by the sprite shader.
+	 * Sprites queued before the change are flushed first so they keep the view they were submitted with.
+	 */
+	void SetViewMatrix(const glm::mat3& view);
+
+	const glm::mat3& GetViewMatrix() const { return m_ViewMatrix; }
+
+	/**
+	 * Moves the camera of the game, the position is the top left corner of the view in world space.
+	 * Static render layers are redrawn because everything on them moves.
+	 */
+	void SetCameraPosition(const glm::vec2& position);
+
+	const glm::vec2& GetCameraPosition() const { return m_CameraPosition; }
+
+	/** The part of the world that is visible in the game, render components outside of it are culled.*/
+	SDL_FRect GetViewRect() const { return { m_CameraPosition.x, m_CameraPosition.y, float(m_GameResWidth), float(m_GameResHeight) }; }
+
+	/**
+	 * Sorts and draws all sprites that have been queued since the last flush, binding every render layer once.
+	 * The queued debug shapes are drawn after the sprites, to the target that was bound before the flush.
+	 */
+	void FlushSprites() const;
+
+	const SpriteBatchStats& GetSpriteBatchStats() const;
+
+	const ShapeBatchStats& GetShapeBatchStats() const;
+
 	size_t GetRenderLayersAmount() const { return m_RenderLayers.size(); }
 
 	const std::vector<std::shared_ptr<RenderTarget>>& GetRenderLayers() const { return m_RenderLayers; }
 
+	/**
+	 * A static render layer keeps its contents between frames, it is only cleared and redrawn after it got invalidated.
+	 * Render components invalidate their layer when their texture, source rectangle or transform changes.
+	 * Every layer is invalidated when a texture that was loading in the background becomes valid.
+	 */
+	void SetRenderLayerStatic(int layer, bool isStatic);
+
+	bool IsRenderLayerStatic(int layer) const { return m_RenderLayerStates[layer].isStatic; }
+
+	/** Redraws the layer next frame if it is static.*/
+	void InvalidateRenderLayer(int layer);
+
+	void InvalidateRenderLayers();
+
+	/**
+	 * False when the layer is static and keeps the contents of the previous frame, sprites submitted to it are skipped.
+	 * Layer -1 is the currently bound target and is always redrawn, layers that do not exist are never drawn.
+	 */
+	bool IsRenderLayerRedrawn(int layer) const
+	{
+		if (layer == -1)
+			return true;
+		return layer >= 0 && size_t(layer) < m_RenderLayerStates.size() && m_RenderLayerStates[layer].isRedrawn;
+	}
+
 	std::mutex& GetOpenGlMutex() { return m_OpenGlLock; }
 
 	void AddGLCallAfterDrawing(const std::function<void()>& call);
 
 private:
 
-	void RenderTexture(GLuint glId, int width, int height, const glm::vec2& pos = { 0.f,0.f }, const glm::vec2& scale = { 1.f,1.f }, float rotation = 0, const glm::vec2& pivot = { 0.5f,0.5f }, const SDL_FRect* srcRect = nullptr, int renderLayer = -1) const;
+	void RenderTexture(GLuint glId, int width, int height, const glm::vec2& pos = { 0.f,0.f }, const glm::vec2& scale = { 1.f,1.f }, float rotation = 0, const glm::vec2& pivot = { 0.5f,0.5f }, const SDL_FRect* srcRect = nullptr, int renderLayer = -1, int depth = 0, const SDL_Color& tint = { 255,255,255,255 }) const;
+
+	void BindRenderTarget(const std::shared_ptr<RenderTarget>& renderTarget) const;
+
+	void UpdateGlobals();
 	
-	virtual ~RenderManager() = default;
-	RenderManager() = default;
+	virtual ~RenderManager();
+	RenderManager();
 	
 	SDL_Window* m_Window{};
 	int m_WindowResWidth{};
@@ -69,15 +148,42 @@ private:
 
 	SDL_GLContext m_pContext{};
 
+	// Maps game resolution pixels to normalized device coordinates
+	glm::mat3 m_ProjectionMatrix{ 1.f };
+	glm::mat3 m_ViewMatrix{ 1.f };
+	glm::vec2 m_CameraPosition{};
+
+	std::unique_ptr<GLSL_GlobalVariables> m_pGlobals;
+	std::unique_ptr<GlUniformBuffer<GLSL_GlobalVariables>> m_pGlobalsBuffer;
+
 	std::vector<std::shared_ptr<RenderTarget>> m_RenderLayers;
 
+	struct RenderLayerState final
+	{
+		bool isStatic{};
+		bool isInvalidated{ true };
+		bool isRedrawn{ true };
+	};
+
+	std::vector<RenderLayerState> m_RenderLayerStates;
+
+	// Target 0 is the currently bound target, target i + 1 is render layer i
+	std::unique_ptr<SpriteBatch> m_pSpriteBatch;
+
+	// Debug shapes, drawn on top of the sprites of their target
+	std::unique_ptr<ShapeBatch> m_pShapeBatch;
+	SDL_Color m_ShapeColor{ 255,255,255,255 };
+
 	std::mutex m_OpenGlLock;
 
 	std::vector<std::function<void()>> m_PostDrawGLCalls;
 
 public:
 
-	/** STATIC FUNCTIONS */
+	/**
+	 * STATIC FUNCTIONS
+	 * The shapes are queued and drawn together on the next flush of the sprites
+	 */
 	static void SetColor(const SDL_Color& color);
 	static void RenderPoint(const glm::vec2& pos, float pointSize = 1, SDL_Color* pColor = nullptr);
 	static void RenderLine(const glm::vec2& begin, const glm::vec2& end, float thickness = 1, SDL_Color* pColor = nullptr);
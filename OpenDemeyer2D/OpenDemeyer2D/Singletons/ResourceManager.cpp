@@ -27,6 +27,8 @@
 #include "EngineFiles/Scene.h"
 
 #include "ImGuiExt/FileDetailView.h"
+#include "EngineIO/BinarySerializer.h"
+#include "UtilityFiles/MappedFile.h"
 
 using namespace std::filesystem;
 
@@ -70,6 +72,7 @@ void ResourceManager::Init(const path& dataPath)
 void ResourceManager::Destroy()
 {
 	m_PrefabScene.reset();
+	m_TextureUploader.Destroy();
 }
 
 #pragma region FileLoaders
@@ -82,21 +85,36 @@ std::shared_ptr<Texture2D> ResourceManager::LoadTexture(const path& file, bool k
 		return it->second.lock();
 	}
 
-	SDL_Surface* pLoadedSurface{};
+	// The file was packed into the atlas before, so there is no need to load it again
+	std::shared_ptr<Texture2D> texture2d = m_TextureAtlas.Find(file);
+
+	if (!texture2d)
 	{
-		path finalPath = GetfinalPath(file);
+		SDL_Surface* pLoadedSurface{};
+		{
+			path finalPath = GetfinalPath(file);
 
-		std::scoped_lock<std::mutex> lock(m_IMGLock);
+			std::scoped_lock<std::mutex> lock(m_IMGLock);
 
-		pLoadedSurface = IMG_Load(finalPath.string().c_str());
-		if (!pLoadedSurface)
+			pLoadedSurface = IMG_Load(finalPath.string().c_str());
+			if (!pLoadedSurface)
+			{
+				//throw std::runtime_error(std::string("Failed to load texture: ") + SDL_GetError());
+				// TODO log error
+			}
+		}
+
+		if (pLoadedSurface)
 		{
-			//throw std::runtime_error(std::string("Failed to load texture: ") + SDL_GetError());
-			// TODO log error
+			// Small textures share a GL texture so they can be batched, larger ones get their own
+			texture2d = m_TextureAtlas.Add(file, pLoadedSurface);
+			if (!texture2d)
+				texture2d = LoadTexture(pLoadedSurface);
+
+			SDL_FreeSurface(pLoadedSurface);
 		}
 	}
 
-	std::shared_ptr<Texture2D> texture2d = pLoadedSurface ? LoadTexture(pLoadedSurface) : nullptr;
 	texture2d->m_sourceFile = file;
 	m_Texture2DFiles.emplace(file, texture2d);
 
@@ -247,11 +265,22 @@ std::shared_ptr<Prefab> ResourceManager::LoadPrefab(const path& file, bool keepL
 	{
 		path finalPath = GetfinalPath(file);
 
-		std::ifstream is(finalPath);
-		Deserializer deserializer{};
+		const path binaryPath = GetBinaryPath(finalPath);
+
 		try
 		{
-			prefab = std::shared_ptr<Prefab>(new Prefab(deserializer.DeserializeObject(is, m_PrefabScene->CreateGameObject())));
+			if (IsBinaryUpToDate(finalPath, binaryPath))
+			{
+				MappedFile mappedFile(binaryPath);
+				BinarySerializer serializer{};
+				prefab = std::shared_ptr<Prefab>(new Prefab(serializer.DeserializeObject(mappedFile, m_PrefabScene->CreateGameObject())));
+			}
+			else
+			{
+				std::ifstream is(finalPath);
+				Deserializer deserializer{};
+				prefab = std::shared_ptr<Prefab>(new Prefab(deserializer.DeserializeObject(is, m_PrefabScene->CreateGameObject())));
+			}
 		}
 		catch (std::exception&)
 		{
@@ -275,6 +304,35 @@ std::shared_ptr<Prefab> ResourceManager::LoadPrefab(const path& file, bool keepL
 
 #pragma region FileLoadersAsync
 
+std::shared_ptr<Texture2D> ResourceManager::LoadTextureAsync(const path& file, bool keepLoaded)
+{
+	auto it = m_Texture2DFiles.find(file);
+	if (it != m_Texture2DFiles.end() && !it->second.expired())
+	{
+		return it->second.lock();
+	}
+
+	std::shared_ptr<Texture2D> texture2d = m_TextureAtlas.Find(file);
+
+	if (!texture2d)
+	{
+		texture2d = std::make_shared<Texture2D>();
+
+		std::scoped_lock<std::mutex> lock(m_TextureQueueLock);
+		m_TextureLoaderQueue.emplace_back(file, texture2d);
+	}
+
+	texture2d->m_sourceFile = file;
+	m_Texture2DFiles.insert_or_assign(file, texture2d);
+
+	if (keepLoaded)
+	{
+		m_AlwaysLoadedTextures.emplace_back(texture2d);
+	}
+
+	return texture2d;
+}
+
 std::shared_ptr<Surface2D> ResourceManager::LoadSurfaceAsync(const path& file, bool keepLoaded)
 {
 	auto it = m_Surface2DFiles.find(file);
@@ -417,6 +475,7 @@ void ResourceManager::MusicLoaderThread()
 void ResourceManager::SurfaceLoaderThread()
 {
 	auto& queue = m_SurfaceLoaderQueue;
+	auto& textureQueue = m_TextureLoaderQueue;
 
 	bool* terminate{ &m_TerminateLoaderThreads };
 	std::condition_variable threadIdle;
@@ -425,15 +484,53 @@ void ResourceManager::SurfaceLoaderThread()
 
 	while (true)
 	{
-		threadIdle.wait_for(uniqueWaitLock, 100ms, [&terminate, &queue]
+		threadIdle.wait_for(uniqueWaitLock, 100ms, [&terminate, &queue, &textureQueue]
 			{
-				return (*terminate || !queue.empty());
+				return (*terminate || !queue.empty() || !textureQueue.empty());
 			});
 
 		// terminate the thread if terminateLoaderThreads is true
 		if (*terminate)
 			return;
 
+		// Decode the textures of LoadTextureAsync here, the render thread only has to upload them
+		if (!textureQueue.empty())
+		{
+			std::pair<path, std::shared_ptr<Texture2D>> entry;
+			{
+				std::scoped_lock<std::mutex> lock(m_TextureQueueLock);
+				entry = textureQueue.front();
+				textureQueue.pop_front();
+			}
+
+			SDL_Surface* pLoadedSurface{};
+			{
+				path finalPath = GetfinalPath(entry.first);
+
+				std::scoped_lock<std::mutex> lock(m_IMGLock);
+
+				pLoadedSurface = IMG_Load(finalPath.string().c_str());
+			}
+
+			// Convert to the format the uploader expects while still on this thread
+			SDL_Surface* pConverted{};
+			if (pLoadedSurface)
+			{
+				pConverted = SDL_ConvertSurfaceFormat(pLoadedSurface, SDL_PIXELFORMAT_RGBA32, 0);
+				SDL_FreeSurface(pLoadedSurface);
+			}
+
+			if (pConverted)
+			{
+				m_TextureUploader.Enqueue(entry.second, entry.first, pConverted);
+			}
+			else
+			{
+				std::cerr << "Failed to load texture " << entry.first << ": " << SDL_GetError() << '\n';
+				entry.second->m_HasFailed = true;
+			}
+		}
+
 		if (queue.empty())
 			continue;
 
@@ -583,15 +680,122 @@ std::filesystem::path ResourceManager::GetRelativePath(const path& inputPath)
 	return inputPath;
 }
 
+path ResourceManager::GetBinaryPath(const path& textPath)
+{
+	path binaryPath{ textPath };
+	return binaryPath.replace_extension(".b" + textPath.extension().string().substr(1));
+}
+
+path ResourceManager::GetTextPath(const path& binaryPath)
+{
+	path textPath{ binaryPath };
+	return textPath.replace_extension("." + binaryPath.extension().string().substr(2));
+}
+
+bool ResourceManager::IsBinaryUpToDate(const path& textPath, const path& binaryPath)
+{
+	std::error_code error{};
+	const auto binaryTime{ last_write_time(binaryPath, error) };
+	if (error)
+		return false;
+
+	const auto textTime{ last_write_time(textPath, error) };
+	return error || binaryTime >= textTime;
+}
+
 Scene* ResourceManager::LoadScene(const path& file)
 {
-	Deserializer deserializer;
-	auto stream = std::ifstream(GetfinalPath(file));
-	auto scene = deserializer.DeserializeScene(stream);
+	const auto start{ std::chrono::steady_clock::now() };
+
+	const path finalPath{ GetfinalPath(file) };
+	const path binaryPath{ GetBinaryPath(finalPath) };
+
+	Scene* scene{};
+	m_LastSceneLoadWasBinary = IsBinaryUpToDate(finalPath, binaryPath);
+	if (m_LastSceneLoadWasBinary)
+	{
+		try
+		{
+			MappedFile mappedFile(binaryPath);
+			BinarySerializer serializer;
+			scene = serializer.DeserializeScene(mappedFile);
+		}
+		catch (ParsingError&)
+		{
+			// fall back on the text file
+			m_LastSceneLoadWasBinary = false;
+		}
+	}
+	if (!scene)
+	{
+		Deserializer deserializer;
+		auto stream = std::ifstream(finalPath);
+		scene = deserializer.DeserializeScene(stream);
+	}
+
 	scene->m_FilePath = GetRelativePath(file);
+
+	m_LastSceneLoadTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
 	return scene;
 }
 
+Scene* ResourceManager::StreamScene(const path& file, float frameBudget)
+{
+	const path finalPath{ GetfinalPath(file) };
+	const path binaryPath{ GetBinaryPath(finalPath) };
+
+	Scene* scene{ new Scene(finalPath.stem().string()) };
+	scene->m_FilePath = GetRelativePath(file);
+	scene->StreamObjects(IsBinaryUpToDate(finalPath, binaryPath) ? binaryPath : finalPath, frameBudget);
+	return scene;
+}
+
+void ResourceManager::ConvertToBinary(const path& file)
+{
+	const path textPath{ GetfinalPath(file) };
+	std::ifstream is(textPath);
+	Deserializer deserializer;
+	BinarySerializer serializer;
+
+	if (textPath.extension() == ".scene")
+	{
+		std::unique_ptr<Scene> pScene{ deserializer.DeserializeScene(is) };
+		auto of = std::ofstream(GetBinaryPath(textPath), std::ios::binary);
+		serializer.SerializeScene(of, pScene.get());
+	}
+	else
+	{
+		Scene scene("Converter Scene");
+		GameObject* pObject{ deserializer.DeserializeObject(is, scene.CreateGameObject()) };
+		auto of = std::ofstream(GetBinaryPath(textPath), std::ios::binary);
+		serializer.SerializeObject(of, pObject);
+	}
+}
+
+void ResourceManager::ConvertToText(const path& file)
+{
+	path binaryPath{ GetfinalPath(file) };
+	if (binaryPath.extension() == ".scene" || binaryPath.extension() == ".gobj")
+		binaryPath = GetBinaryPath(binaryPath);
+
+	MappedFile mappedFile(binaryPath);
+	BinarySerializer serializer;
+
+	if (binaryPath.extension() == ".bscene")
+	{
+		std::unique_ptr<Scene> pScene{ serializer.DeserializeScene(mappedFile) };
+		auto of = std::ofstream(GetTextPath(binaryPath));
+		pScene->Serialize(of);
+	}
+	else
+	{
+		Scene scene("Converter Scene");
+		GameObject* pObject{ serializer.DeserializeObject(mappedFile, scene.CreateGameObject()) };
+		auto of = std::ofstream(GetTextPath(binaryPath));
+		pObject->Serialize(of);
+	}
+}
+
 void ResourceManager::DeleteDirectory(Directory* dir)
 {
 	remove_all(dir->dirPath);
@@ -625,9 +829,16 @@ void ResourceManager::SaveGameObject(GameObject* pGameObject, path& outPutPath)
 	if (!outPutPath.has_extension())
 		outPutPath += ".gobj";
 
-	auto of = std::ofstream(outPutPath);
-
-	pGameObject->Serialize(of);
+	{
+		auto of = std::ofstream(outPutPath);
+		pGameObject->Serialize(of);
+	}
+	{
+		// written after the text file so it is seen as up to date
+		auto of = std::ofstream(GetBinaryPath(outPutPath), std::ios::binary);
+		BinarySerializer serializer;
+		serializer.SerializeObject(of, pGameObject);
+	}
 
 	auto newGo = m_PrefabScene->CreateGameObject();
 	newGo->Copy(pGameObject);
@@ -645,12 +856,19 @@ void ResourceManager::SaveScene(Scene* pScene, const path& outPutPath)
 	if (!finalPath.has_extension())
 		finalPath += ".scene";
 
-	auto of = std::ofstream(finalPath);
-
 	// change the name of the scene
 	pScene->ChangeName(outPutPath.stem().string());
 
-	pScene->Serialize(of);
+	{
+		auto of = std::ofstream(finalPath);
+		pScene->Serialize(of);
+	}
+	{
+		// written after the text file so it is seen as up to date
+		auto of = std::ofstream(GetBinaryPath(finalPath), std::ios::binary);
+		BinarySerializer serializer;
+		serializer.SerializeScene(of, pScene);
+	}
 
 	auto dir = GetDirectory(finalPath);
 
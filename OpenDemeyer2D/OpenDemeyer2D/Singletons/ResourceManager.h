@@ -14,6 +14,9 @@
 
 #include "UtilityFiles/Singleton.h"
 #include "ImGuiExt/FileDetailView.h"
+#include "ResourceWrappers/TextureAtlas.h"
+#include "ResourceWrappers/TextureUploader.h"
+#include "EngineIO/SceneStreamer.h"
 #define RESOURCES ResourceManager::GetInstance()
 
 class Texture2D;
@@ -64,13 +67,36 @@ public: //**// TEXTURE2D //**//
 	std::shared_ptr<Texture2D> LoadTexture(SDL_Surface* pSurface);
 	std::shared_ptr<Texture2D> LoadTexture(int width, int height);
 
+	/**
+	 * Returns a texture that stays invalid until the file is decoded on the loader thread and uploaded.
+	 * The upload is spread over multiple frames, see TextureUploader.
+	 * If the file can not be decoded the texture stays invalid and Texture2D::HasFailed returns true.
+	 */
+	std::shared_ptr<Texture2D> LoadTextureAsync(const std::filesystem::path& relativePath, bool keepLoaded = false);
+
+	/** Continues the uploads of the textures loaded with LoadTextureAsync. Gets called once per frame.*/
+	void UploadTextures() { m_TextureUploader.Update(); }
+
+	const TextureUploader& GetTextureUploader() const { return m_TextureUploader; }
+
 	const std::unordered_map<std::filesystem::path, std::weak_ptr<Texture2D>>& GetTexture2DFiles() const { return m_Texture2DFiles; }
 
+	/** Returns the atlas that the texture files get packed into*/
+	const TextureAtlas& GetTextureAtlas() const { return m_TextureAtlas; }
+
 private:
 
 	std::vector<std::shared_ptr<Texture2D>> m_AlwaysLoadedTextures;
 	std::unordered_map<std::filesystem::path, std::weak_ptr<Texture2D>> m_Texture2DFiles;
 
+	TextureAtlas m_TextureAtlas;
+
+	/** Declared after the atlas because it packs small textures into it*/
+	TextureUploader m_TextureUploader{ m_TextureAtlas };
+
+	std::deque<std::pair<std::filesystem::path, std::shared_ptr<Texture2D>>> m_TextureLoaderQueue;
+	std::mutex m_TextureQueueLock;
+
 	std::mutex m_IMGLock;
 
 public: //**// SURFACE2D //**//
@@ -96,6 +122,8 @@ public: //**// FONT //**//
 
 	std::shared_ptr<Font> LoadFont(const std::filesystem::path& file, uint32_t size, bool keepLoaded = false);
 
+	const std::map<std::pair<std::filesystem::path, unsigned int>, std::weak_ptr<Font>>& GetLoadedFonts() const { return m_LoadedFonts; }
+
 private:
 
 	//std::unordered_map<std::pair<std::string, uint32_t size>, std::weak_ptr<Font>> m_FontFiles;
@@ -162,8 +190,24 @@ private:
 
 public:
 
+	/** Loads the binary version of the scene when it is at least as new as the text file, see BinarySerializer*/
 	Scene* LoadScene(const std::filesystem::path& file);
 
+	/**
+	* Returns an empty scene that the objects of the file are streamed into over multiple frames, see SceneStreamer.
+	* The progress can be followed through Scene::GetStreamers.
+	*/
+	Scene* StreamScene(const std::filesystem::path& file, float frameBudget = SceneStreamer::DefaultFrameBudget);
+
+	/** Duration of the last LoadScene call in milliseconds*/
+	float GetLastSceneLoadTime() const { return m_LastSceneLoadTime; }
+	bool WasLastSceneLoadBinary() const { return m_LastSceneLoadWasBinary; }
+
+	/** Writes the binary version of a .scene or .gobj file next to it*/
+	void ConvertToBinary(const std::filesystem::path& file);
+	/** Writes the text version of a .scene or .gobj file from its binary version*/
+	void ConvertToText(const std::filesystem::path& file);
+
 	Directory* GetRootDirectory() const { return m_RootDirectory; }
 	void DeleteDirectory(Directory* dir);
 	void AddDirectory(Directory* root, const std::string& dirName);
@@ -190,12 +234,22 @@ private:
 	 */
 	std::filesystem::path GetRelativePath(const std::filesystem::path& inputPath);
 
+	/** Returns the path of the binary version of a text file: .scene becomes .bscene and .gobj becomes .bgobj*/
+	static std::filesystem::path GetBinaryPath(const std::filesystem::path& textPath);
+	static std::filesystem::path GetTextPath(const std::filesystem::path& binaryPath);
+
+	/** The binary file is only used if it was written after the last change to the text file*/
+	static bool IsBinaryUpToDate(const std::filesystem::path& textPath, const std::filesystem::path& binaryPath);
+
 private:
 	
 	bool m_TerminateLoaderThreads{};
 
 	std::filesystem::path m_DataPath;
 
+	float m_LastSceneLoadTime{};
+	bool m_LastSceneLoadWasBinary{};
+
 	// TODO change this into a unordered_map. needs a special hash funtion
 	std::map<std::pair<std::filesystem::path, unsigned int>, std::weak_ptr<Font>> m_LoadedFonts;
 
@@ -4,6 +4,7 @@
 #include <b2_contact.h>
 
 #include "EngineFiles/Scene.h"
+#include "Singletons/RenderManager.h"
 #include "imgui.h"
 
 void SceneManager::Destroy()
@@ -103,6 +104,7 @@ void SceneManager::SetActiveScene(Scene* pScene)
 	if (!pScene || pScene == m_GameScene.get()) return;
 
 	m_pActiveScene = pScene;
+	RENDER.InvalidateRenderLayers();
 
 	for (auto scene : m_Scenes)
 	{
@@ -176,12 +178,23 @@ void SceneManager::PlayScene(Scene* pScene)
 	Scene* sceneToPlay = pScene ? pScene : m_pActiveScene;
 	if (sceneToPlay)
 	{
+		const auto start{ std::chrono::steady_clock::now() };
+
 		m_GameScene = std::unique_ptr<Scene>(new Scene("Game"));
-		m_GameScene->Copy(sceneToPlay);
+
+		// the snapshot copies the other fields from the original scene, so it is cleared straight away
+		m_PlaySnapshot.Compile(sceneToPlay->GetSceneTree());
+		m_PlaySnapshot.InstantiateAll(m_GameScene.get());
+		m_PlaySnapshot.Clear();
+
+		m_LastPlaySceneTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
 	}
 #else
 	m_GameScene = std::unique_ptr<Scene>(pScene);
 #endif
+
+	// The game scene is rendered instead of the active scene from now on
+	RENDER.InvalidateRenderLayers();
 }
 
 void SceneManager::StopPlayingScene()
@@ -189,5 +202,6 @@ void SceneManager::StopPlayingScene()
 	if (m_GameScene)
 	{
 		m_GameScene.reset();
+		RENDER.InvalidateRenderLayers();
 	}
 }
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include <vector>
 #include <memory>
 
+#include "ResourceWrappers/PrefabTemplate.h"
+
 #define SCENES SceneManager::GetInstance()
 
 class Scene;
@@ -68,9 +70,13 @@ public:
 	/** 
 	* Start playing the scene.
 	* If pScene is nullptr it will start playing the active scene.
+	* The objects of the scene are compiled into a snapshot that the game scene is instantiated from, see PrefabTemplate.
 	*/
 	void PlayScene(Scene* pScene = nullptr);
 
+	/** Duration of the last PlayScene call in milliseconds*/
+	float GetLastPlaySceneTime() const { return m_LastPlaySceneTime; }
+
 	void StopPlayingScene();
 
 	const std::unique_ptr<Scene>& GetGameScene() const { return m_GameScene; }
@@ -81,6 +87,10 @@ private:
 
 	std::unique_ptr<Scene> m_GameScene;
 
+	/** Snapshot of the scene that is started, only used while starting it. Kept to reuse its memory*/
+	PrefabTemplate m_PlaySnapshot;
+	float m_LastPlaySceneTime{};
+
 	//std::vector<GameObject*> m_Prefabs;
 
 	Scene* m_pActiveScene{};
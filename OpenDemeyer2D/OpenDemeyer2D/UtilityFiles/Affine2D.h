@@ -0,0 +1,39 @@
+﻿#pragma once
+
+#include "glm/glm.hpp"
+
+/**
+ * 2D affine transformation, the top two rows of a 3x3 matrix whose last row is always [0 0 1].
+ * | a b x |
+ * | c d y |
+ */
+struct Affine2D final
+{
+	float a{ 1.f }, b{ 0.f }, c{ 0.f }, d{ 1.f };
+	float x{ 0.f }, y{ 0.f };
+
+	/** Builds the matrix from a position, a scale and the sine and cosine of the rotation.*/
+	static Affine2D FromTransform(const glm::vec2& position, const glm::vec2& scale, float sinAngle, float cosAngle)
+	{
+		return Affine2D{
+			scale.x * cosAngle, -scale.x * sinAngle,
+			scale.y * sinAngle, scale.y * cosAngle,
+			position.x, position.y };
+	}
+
+	/** Applies other first and this second. Only needs 12 multiplications as the last row is constant.*/
+	Affine2D operator*(const Affine2D& other) const
+	{
+		return Affine2D{
+			a * other.a + b * other.c, a * other.b + b * other.d,
+			c * other.a + d * other.c, c * other.b + d * other.d,
+			a * other.x + b * other.y + x, c * other.x + d * other.y + y };
+	}
+
+	glm::vec2 TransformPoint(const glm::vec2& point) const
+	{
+		return { a * point.x + b * point.y + x, c * point.x + d * point.y + y };
+	}
+
+	glm::vec2 GetPosition() const { return { x, y }; }
+};
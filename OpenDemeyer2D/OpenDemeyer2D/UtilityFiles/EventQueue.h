@@ -20,7 +20,7 @@ public:
 
 	static std::tuple<EventParameters...> GetMessage()
 	{
-		auto message = m_InputQueue.front();
+		auto message = std::move(m_InputQueue.front());
 		m_InputQueue.pop_front();
 		return message;
 	}
@@ -0,0 +1,76 @@
+﻿#include "pch.h"
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& file)
+{
+	HANDLE fileHandle{ CreateFileW(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr) };
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		return;
+	m_File = fileHandle;
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(fileHandle, &size) || size.QuadPart == 0)
+		return;
+
+	m_Mapping = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!m_Mapping)
+		return;
+
+	m_pData = static_cast<const uint8_t*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+	if (m_pData)
+		m_Size = size_t(size.QuadPart);
+}
+
+MappedFile::~MappedFile()
+{
+	if (m_pData)
+		UnmapViewOfFile(m_pData);
+	if (m_Mapping)
+		CloseHandle(m_Mapping);
+	if (m_File)
+		CloseHandle(m_File);
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& file)
+{
+	const int fileHandle{ open(file.c_str(), O_RDONLY) };
+	if (fileHandle == -1)
+		return;
+
+	struct stat status {};
+	if (fstat(fileHandle, &status) == 0 && status.st_size > 0)
+	{
+		void* pData = mmap(nullptr, size_t(status.st_size), PROT_READ, MAP_PRIVATE, fileHandle, 0);
+		if (pData != MAP_FAILED)
+		{
+			m_pData = static_cast<const uint8_t*>(pData);
+			m_Size = size_t(status.st_size);
+		}
+	}
+
+	// The mapping stays valid after the file is closed
+	close(fileHandle);
+}
+
+MappedFile::~MappedFile()
+{
+	if (m_pData)
+		munmap(const_cast<uint8_t*>(m_pData), m_Size);
+}
+
+#endif
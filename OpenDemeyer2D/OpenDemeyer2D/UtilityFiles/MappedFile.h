@@ -0,0 +1,36 @@
+﻿#pragma once
+#include <filesystem>
+#include <cstdint>
+
+/**
+ * Read only view of a file that is mapped into memory.
+ * The pages are loaded by the OS when they are first touched, nothing gets copied into a buffer.
+ */
+class MappedFile final
+{
+public:
+
+	explicit MappedFile(const std::filesystem::path& file);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile(MappedFile&&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile& operator=(MappedFile&&) = delete;
+
+	const uint8_t* GetData() const { return m_pData; }
+	size_t GetSize() const { return m_Size; }
+
+	bool IsValid() const { return m_pData; }
+
+private:
+
+	const uint8_t* m_pData{};
+	size_t m_Size{};
+
+#ifdef _WIN32
+	void* m_File{};
+	void* m_Mapping{};
+#endif
+
+};
@@ -5,6 +5,7 @@
 #include "Allocators/SmallObjectAllocator.h"
 #include "Allocators/ObjectPoolAllocator.h"
 #include "Allocators/Mallocator.h"
+#include "Allocators/FrameAllocator.h"
 
 #include <vector>
 #include <set>
@@ -3,22 +3,21 @@
 in GS_OUT
 {
 	vec4 color;
-	vec4 centerPos; //w is radius
+	vec2 localPos; // -1 to 1 over the square around the circle
+	float lineWidth;
 } fs_in;
 
 out vec4 color;
 
-float SquareDistance(vec2 v0, vec2 v1)
-{
-	return (v0.x - v1.x) * (v0.x - v1.x) + (v0.y - v1.y) * (v0.y - v1.y);
-}
-
 void main()
 {
-	color = fs_in.color;
+	float distance = length(fs_in.localPos);
 
-	//vec2 pixelCoord = gl_FragCoord.xy;
-	//float radius = fs_in.centerPos.w;
-	//
-	//color = clamp(SquareDistance(pixelCoord, fs_in.centerPos.xy) - radius*radius,0,1) * fs_in.color;
+	// fwidth gives the size of a pixel in local space, so outlines keep their width in pixels
+	float pixelSize = fwidth(distance);
+
+	if (distance > 1 || (fs_in.lineWidth > 0 && distance < 1 - fs_in.lineWidth * pixelSize))
+		discard;
+
+	color = fs_in.color;
 }
\ No newline at end of file
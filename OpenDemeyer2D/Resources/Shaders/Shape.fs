@@ -0,0 +1,13 @@
+#version 330 core
+
+in VS_OUT
+{
+	vec4 color;
+} fs_in;
+
+out vec4 color;
+
+void main()
+{
+	color = fs_in.color;
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#version 330 core
+
+layout (location = 0) in vec2 position;
+layout (location = 1) in vec4 color;
+
+layout (std140) uniform Globals
+{
+	mat3 view;
+	mat3 invView;
+	float time;
+	float deltaTime;
+};
+
+out VS_OUT
+{
+	vec4 color;
+} vs_out;
+
+void main()
+{
+	vs_out.color = color;
+	gl_Position = vec4((view * vec3(position, 1)).xy, 0, 1);
+}
\ No newline at end of file
@@ -2,39 +2,45 @@
 layout (points) in;
 layout (triangle_strip, max_vertices = 4) out;
 
-uniform mat3 cameraTransform = mat3(1.0,0.0,0.0,0.0,1.0,0.0,0.0,0.0,1.0);
+layout (std140) uniform Globals
+{
+	mat3 view;
+	mat3 invView;
+	float time;
+	float deltaTime;
+};
 
 in VS_OUT
 {
-	mat3 transform;
+	vec4 centerRadii;
 	vec4 color;
+	float lineWidth;
 } gs_in[];
 
 out GS_OUT
 {
 	vec4 color;
-	vec4 centerPos; //w is radius
+	vec2 localPos; // -1 to 1 over the square around the circle
+	float lineWidth;
 } gs_out;
 
-void main()
+void EmitCorner(vec2 corner)
 {
-	// Set the color for all output vertices
 	gs_out.color = gs_in[0].color;
-	
-	// Keep the center position of the square (original position)
-	gs_out.centerPos = gl_in[0].gl_Position;
-	
-	gl_Position = vec4(cameraTransform * (gs_in[0].transform * vec3(gs_out.centerPos.xy + vec2(-1,-1), 1)), 1);
-	EmitVertex();
-	
-	gl_Position = vec4(cameraTransform * (gs_in[0].transform * vec3(gs_out.centerPos.xy + vec2( 1,-1), 1)), 1);
-	EmitVertex();
-	
-	gl_Position = vec4(cameraTransform * (gs_in[0].transform * vec3(gs_out.centerPos.xy + vec2(-1, 1), 1)), 1);
-	EmitVertex();
-	
-	gl_Position = vec4(cameraTransform * (gs_in[0].transform * vec3(gs_out.centerPos.xy + vec2( 1, 1), 1)), 1);
+	gs_out.localPos = corner;
+	gs_out.lineWidth = gs_in[0].lineWidth;
+
+	vec2 world = gs_in[0].centerRadii.xy + corner * gs_in[0].centerRadii.zw;
+	gl_Position = vec4((view * vec3(world, 1)).xy, 0, 1);
 	EmitVertex();
-	
+}
+
+void main()
+{
+	EmitCorner(vec2(-1,-1));
+	EmitCorner(vec2( 1,-1));
+	EmitCorner(vec2(-1, 1));
+	EmitCorner(vec2( 1, 1));
+
 	EndPrimitive();
 }
\ No newline at end of file
@@ -1,23 +1,20 @@
 #version 330 core
 
-layout (location = 0) in mat3 transform;
-layout (location = 3) in vec4 color;
-
-// in VS_IN
-// {
-	// mat3 transform;
-	// vec4 color;
-// } vs_in;
+layout (location = 0) in vec4 centerRadii;	// center in xy, radii in zw
+layout (location = 1) in vec4 color;
+layout (location = 2) in float lineWidth;	// 0 for a filled circle
 
 out VS_OUT
 {
-	mat3 transform;
+	vec4 centerRadii;
 	vec4 color;
+	float lineWidth;
 } vs_out;
 
 void main()
 {
-	vs_out.transform = transform;
+	vs_out.centerRadii = centerRadii;
 	vs_out.color = color;
-	gl_Position = vec4(transform[0][2], transform[1][2], 1, 1);
+	vs_out.lineWidth = lineWidth;
+	gl_Position = vec4(centerRadii.xy, 0, 1);
 }
\ No newline at end of file
@@ -0,0 +1,16 @@
+#version 330 core
+
+uniform sampler2D sprite;
+
+in VS_OUT
+{
+	vec2 texCoord;
+	vec4 tint;
+} fs_in;
+
+out vec4 color;
+
+void main()
+{
+	color = texture(sprite, fs_in.texCoord) * fs_in.tint;
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#version 330 core
+
+// One instance per sprite, the quad corners come from gl_VertexID (triangle strip)
+layout (location = 0) in vec4 linear;		// a b c d of the 2x3 transform, includes the size of the source rectangle
+layout (location = 1) in vec2 translation;
+layout (location = 2) in vec2 pivot;
+layout (location = 3) in vec4 sourceRect;	// left, top, right, bottom in texture coordinates
+layout (location = 4) in vec4 tint;
+
+layout (std140) uniform Globals
+{
+	mat3 view;
+	mat3 invView;
+	float time;
+	float deltaTime;
+};
+
+out VS_OUT
+{
+	vec2 texCoord;
+	vec4 tint;
+} vs_out;
+
+void main()
+{
+	vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+
+	vec2 local = corner + pivot - vec2(1, 1);
+	vec2 world = mat2(linear.x, linear.z, linear.y, linear.w) * local + translation;
+
+	vs_out.texCoord = vec2(mix(sourceRect.x, sourceRect.z, corner.x), mix(sourceRect.w, sourceRect.y, corner.y));
+	vs_out.tint = tint;
+	gl_Position = vec4((view * vec3(world, 1)).xy, 0, 1);
+}
\ No newline at end of file